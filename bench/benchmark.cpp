@@ -0,0 +1,155 @@
+#include "benchmark.h"
+
+#include <charconv>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+
+namespace ct::bench {
+
+namespace {
+
+std::size_t parse_size(std::string_view arg) {
+  std::size_t value = 0;
+  auto [end, error] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+  if (error != std::errc() || end != arg.data() + arg.size()) {
+    std::cerr << "Invalid number: " << arg << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  return value;
+}
+
+std::string json_escape(std::string_view str) {
+  std::string result;
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      result.push_back('\\');
+    }
+    result.push_back(c);
+  }
+  return result;
+}
+
+void print_row(std::ostream& out, const Result& result) {
+  double throughput = static_cast<double>(result.bits) / result.ns_per_iteration;
+  out << std::left << std::setw(28) << result.name << ' ' << std::setw(18) << result.implementation << std::right
+      << ' ' << std::setw(12) << result.bits << ' ' << std::fixed << std::setprecision(1) << std::setw(16)
+      << result.ns_per_iteration << ' ' << std::setprecision(3) << std::setw(14) << throughput << '\n'
+      << std::defaultfloat;
+}
+
+} // namespace
+
+Runner::Runner(Options options)
+    : _options(std::move(options)) {}
+
+const Options& Runner::options() const {
+  return _options;
+}
+
+bool Runner::enabled(std::size_t bits) const {
+  return _options.min_bits <= bits && bits <= _options.max_bits;
+}
+
+void Runner::run(
+    std::string_view name,
+    std::string_view implementation,
+    std::size_t bits,
+    const std::function<void()>& body,
+    const std::function<void()>& setup
+) {
+  using Clock = std::chrono::steady_clock;
+
+  std::string full_name = std::string(name) + "/" + std::string(implementation);
+  if (full_name.find(_options.filter) == std::string::npos) {
+    return;
+  }
+
+  std::size_t iterations = 1;
+  std::chrono::nanoseconds elapsed{};
+  while (true) {
+    if (setup) {
+      setup();
+    }
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+      body();
+    }
+    elapsed = Clock::now() - start;
+    if (elapsed >= _options.min_time) {
+      break;
+    }
+    iterations *= 2;
+  }
+
+  Result& result = _results.emplace_back(
+      std::string(name),
+      std::string(implementation),
+      bits,
+      iterations,
+      static_cast<double>(elapsed.count()) / static_cast<double>(iterations)
+  );
+  print_row(std::cerr, result);
+}
+
+void Runner::print_table(std::ostream& out) const {
+  out << std::left << std::setw(28) << "benchmark" << ' ' << std::setw(18) << "implementation" << std::right << ' '
+      << std::setw(12) << "bits" << ' ' << std::setw(16) << "ns/op" << ' ' << std::setw(14) << "Gbit/s" << '\n';
+  for (const Result& result : _results) {
+    print_row(out, result);
+  }
+}
+
+void Runner::write_json(std::ostream& out) const {
+  out << "{\n  \"context\": {\n";
+  out << "    \"min_time_ns\": " << _options.min_time.count() << ",\n";
+#ifdef NDEBUG
+  out << "    \"assertions\": false\n";
+#else
+  out << "    \"assertions\": true\n";
+#endif
+  out << "  },\n  \"benchmarks\": [";
+  for (std::size_t i = 0; i < _results.size(); ++i) {
+    const Result& result = _results[i];
+    out << (i == 0 ? "\n" : ",\n");
+    out << "    {\"name\": \"" << json_escape(result.name) << "\", \"implementation\": \""
+        << json_escape(result.implementation) << "\", \"bits\": " << result.bits
+        << ", \"iterations\": " << result.iterations << ", \"ns_per_op\": " << std::setprecision(6)
+        << result.ns_per_iteration << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+Options parse_options(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    auto value = [&]() -> std::string_view {
+      if (i + 1 == argc) {
+        std::cerr << "Missing value for " << arg << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      return argv[++i];
+    };
+
+    if (arg == "--min-bits") {
+      options.min_bits = parse_size(value());
+    } else if (arg == "--max-bits") {
+      options.max_bits = parse_size(value());
+    } else if (arg == "--min-time-ms") {
+      options.min_time = std::chrono::milliseconds(parse_size(value()));
+    } else if (arg == "--filter") {
+      options.filter = value();
+    } else if (arg == "--json") {
+      options.json_path = value();
+    } else {
+      std::cerr << "Usage: " << argv[0]
+                << " [--min-bits N] [--max-bits N] [--min-time-ms N] [--filter SUBSTRING] [--json PATH]" << std::endl;
+      std::exit(arg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+  }
+  return options;
+}
+
+} // namespace ct::bench
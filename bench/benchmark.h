@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ct::bench {
+
+// Keeps the compiler from optimizing away a computed value
+template <typename T>
+void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+struct Options {
+  std::size_t min_bits = 64;
+  std::size_t max_bits = std::size_t(1) << 30;
+  std::chrono::nanoseconds min_time = std::chrono::milliseconds(100);
+  std::string filter;
+  std::string json_path;
+};
+
+struct Result {
+  std::string name;
+  std::string implementation;
+  std::size_t bits;
+  std::size_t iterations;
+  double ns_per_iteration;
+};
+
+// Runs each benchmark until it has taken at least `Options::min_time`, doubling the number of iterations between
+// attempts, and collects the timings
+class Runner {
+public:
+  explicit Runner(Options options);
+
+  const Options& options() const;
+
+  bool enabled(std::size_t bits) const;
+
+  // `body` is called `iterations` times per measurement; `setup`, if given, runs untimed before each measurement.
+  // Benchmarks whose "name/implementation" doesn't contain `Options::filter` are skipped.
+  void run(
+      std::string_view name,
+      std::string_view implementation,
+      std::size_t bits,
+      const std::function<void()>& body,
+      const std::function<void()>& setup = {}
+  );
+
+  void print_table(std::ostream& out) const;
+  void write_json(std::ostream& out) const;
+
+private:
+  Options _options;
+  std::vector<Result> _results;
+};
+
+Options parse_options(int argc, char** argv);
+
+void run_bitset_benchmarks(Runner& runner);
+void run_matrix_benchmarks(Runner& runner);
+void run_bloom_benchmarks(Runner& runner);
+void run_reduce_benchmarks(Runner& runner);
+void run_bfs_benchmarks(Runner& runner);
+
+} // namespace ct::bench
@@ -0,0 +1,102 @@
+#include "benchmark.h"
+#include "bitset-bfs.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace ct::bench {
+
+namespace {
+
+constexpr std::array<std::size_t, 2> VERTICES = {std::size_t(1) << 16, std::size_t(1) << 20};
+constexpr std::size_t DEGREE = 16;
+constexpr std::uint64_t SEED = 42;
+
+// Symmetric random graph where every vertex has `DEGREE` edges on average
+struct RandomGraph {
+  std::vector<std::uint64_t> offsets;
+  std::vector<std::uint32_t> targets;
+
+  explicit RandomGraph(std::size_t vertices)
+      : offsets(vertices + 1, 0)
+      , targets(vertices * DEGREE) {
+    std::mt19937_64 rng(SEED);
+    std::uniform_int_distribution<std::uint32_t> vertex(0, static_cast<std::uint32_t>(vertices - 1));
+    std::vector<std::uint32_t> edges(vertices * DEGREE);
+    for (std::size_t i = 0; i < edges.size(); i += 2) {
+      edges[i] = vertex(rng);
+      edges[i + 1] = vertex(rng);
+      ++offsets[edges[i] + 1];
+      ++offsets[edges[i + 1] + 1];
+    }
+    for (std::size_t i = 0; i < vertices; ++i) {
+      offsets[i + 1] += offsets[i];
+    }
+    std::vector<std::uint64_t> position(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i < edges.size(); i += 2) {
+      targets[position[edges[i]]++] = edges[i + 1];
+      targets[position[edges[i + 1]]++] = edges[i];
+    }
+  }
+
+  CsrGraph csr() const {
+    return {offsets, targets};
+  }
+};
+
+// Textbook top-down search with a queue and a `std::vector<bool>` of visited vertices
+void queue_bfs(const CsrGraph& graph, std::uint32_t source, std::vector<std::uint32_t>& parents) {
+  std::vector<bool> visited(graph.vertices(), false);
+  std::vector<std::uint32_t> queue = {source};
+  std::ranges::fill(parents, BreadthFirstSearch::NO_PARENT);
+  visited[source] = true;
+  parents[source] = source;
+  for (std::size_t i = 0; i < queue.size(); ++i) {
+    for (std::uint32_t neighbour : graph.neighbours(queue[i])) {
+      if (!visited[neighbour]) {
+        visited[neighbour] = true;
+        parents[neighbour] = queue[i];
+        queue.push_back(neighbour);
+      }
+    }
+  }
+}
+
+} // namespace
+
+void run_bfs_benchmarks(Runner& runner) {
+  for (std::size_t vertices : VERTICES) {
+    if (!runner.enabled(vertices)) {
+      continue;
+    }
+    RandomGraph graph(vertices);
+
+    BreadthFirstSearch search(graph.csr());
+    runner.run("bfs", "ct::BreadthFirstSearch", vertices, [&] {
+      search.run(0);
+      do_not_optimize(search.parents().data());
+    });
+
+    std::size_t threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    if (threads > 1) {
+      BreadthFirstSearch parallel(graph.csr(), threads);
+      runner.run("bfs", "ct::BreadthFirstSearch, all threads", vertices, [&] {
+        parallel.run(0);
+        do_not_optimize(parallel.parents().data());
+      });
+    }
+
+    std::vector<std::uint32_t> parents(vertices);
+    runner.run("bfs", "queue with std::vector<bool>", vertices, [&] {
+      queue_bfs(graph.csr(), 0, parents);
+      do_not_optimize(parents.data());
+    });
+  }
+}
+
+} // namespace ct::bench
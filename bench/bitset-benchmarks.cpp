@@ -0,0 +1,483 @@
+#include "benchmark.h"
+#include "bitset-complement.h"
+#include "bitset-extract.h"
+#include "bitset-random.h"
+#include "bitset-shared.h"
+#include "bitset-stream.h"
+#include "bitset-tracked.h"
+#include "bitset.h"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ct::bench {
+
+namespace {
+
+constexpr std::array<std::size_t, 5> SIZES = {
+    std::size_t(1) << 6,
+    std::size_t(1) << 12,
+    std::size_t(1) << 18,
+    std::size_t(1) << 24,
+    std::size_t(1) << 30,
+};
+
+// Parsing and printing allocate a byte per bit, so they are measured on moderate sizes only
+constexpr std::size_t MAX_STRING_BITS = std::size_t(1) << 24;
+constexpr std::size_t RANDOM_ACCESSES = 4096;
+constexpr std::size_t SHIFT = 17;
+constexpr std::size_t FIELD_BITS = 13;
+constexpr std::uint64_t SEED = 42;
+
+BitSet random_bitset(std::size_t bits, std::mt19937_64& rng) {
+  BitSet result(bits, false);
+  BitSet::View view = result;
+  std::size_t words = detail::word_count(bits);
+  std::generate_n(view.data(), words, std::ref(rng));
+  if (bits % detail::WORD_BITS != 0) {
+    view.data()[words - 1] &= detail::range_mask(0, bits % detail::WORD_BITS);
+  }
+  return result;
+}
+
+std::vector<bool> to_vector(const BitSet& bs) {
+  std::vector<bool> result(bs.size());
+  for (std::size_t i = 0; i < bs.size(); ++i) {
+    result[i] = bs[i];
+  }
+  return result;
+}
+
+std::vector<std::size_t> random_indices(std::size_t bits, std::mt19937_64& rng) {
+  std::vector<std::size_t> result(RANDOM_ACCESSES);
+  std::uniform_int_distribution<std::size_t> distribution(0, bits - 1);
+  std::ranges::generate(result, [&] { return distribution(rng); });
+  return result;
+}
+
+void run_ct_bitset(Runner& runner, std::size_t bits) {
+  constexpr std::string_view IMPL = "ct::BitSet";
+  std::mt19937_64 rng(SEED);
+  BitSet lhs = random_bitset(bits, rng);
+  const BitSet rhs = random_bitset(bits, rng);
+  std::vector<std::size_t> indices = random_indices(bits, rng);
+
+  runner.run("construct", IMPL, bits, [&] { do_not_optimize(BitSet(bits, true)); });
+  runner.run("copy", IMPL, bits, [&] { do_not_optimize(BitSet(rhs)); });
+  const SharedBitSet shared(rhs);
+  runner.run("copy", "ct::SharedBitSet", bits, [&] { do_not_optimize(SharedBitSet(shared)); });
+  if (bits <= MAX_STRING_BITS) {
+    std::string str = to_string(lhs);
+    runner.run("parse", IMPL, bits, [&] { do_not_optimize(BitSet(str)); });
+    runner.run("print", IMPL, bits, [&] { do_not_optimize(to_string(lhs)); });
+  }
+
+  runner.run("push_back", IMPL, bits, [&] {
+    BitSet result;
+    for (std::size_t i = 0; i < bits; ++i) {
+      result.push_back(i % 3 == 0);
+    }
+    do_not_optimize(result);
+  });
+  runner.run("append", IMPL, bits, [&] {
+    BitSet result;
+    for (std::size_t i = 0; i + FIELD_BITS <= bits; i += FIELD_BITS) {
+      result.append(rhs.subview(i, FIELD_BITS));
+    }
+    do_not_optimize(result);
+  });
+  runner.run("append_zeros", IMPL, bits, [&] {
+    BitSet result(FIELD_BITS, true);
+    for (std::size_t i = 0; i < FIELD_BITS; ++i) {
+      result <<= bits;
+      do_not_optimize(result.count());
+    }
+  });
+
+  runner.run("and", IMPL, bits, [&] { lhs &= rhs; });
+  runner.run("or", IMPL, bits, [&] { lhs |= rhs; });
+  runner.run("xor", IMPL, bits, [&] { lhs ^= rhs; });
+  TrackedBitSet tracked(lhs);
+  runner.run("xor", "ct::TrackedBitSet", bits, [&] { tracked ^= rhs; });
+  runner.run("export_delta", "ct::TrackedBitSet", bits, [&] { do_not_optimize(tracked.export_delta()); });
+  runner.run("flip", IMPL, bits, [&] { lhs.flip(); });
+  runner.run("shift_left", IMPL, bits, [&] { do_not_optimize(rhs << SHIFT); });
+  runner.run("shift_right", IMPL, bits, [&] { do_not_optimize(rhs >> SHIFT); });
+  runner.run("shift_in_place", IMPL, bits, [&] { lhs.shift_left(SHIFT); });
+  runner.run("rotate", IMPL, bits, [&] { lhs.rotate_left(bits / 3); });
+  Xoshiro256x4 words(SEED);
+  runner.run("fill_random_half", IMPL, bits, [&] { fill_random(lhs, words, 0.5); });
+  runner.run("fill_random_tenth", IMPL, bits, [&] { fill_random(lhs, words, 0.1); });
+  runner.run("fill_random_tenth", "ct::BitSet with mt19937_64", bits, [&] { fill_random(lhs, rng, 0.1); });
+  runner.run("reverse", IMPL, bits, [&] { lhs.reverse(); });
+  runner.run("reversed_copy", IMPL, bits, [&] { do_not_optimize(reversed(rhs)); });
+
+  const BitSet ones(bits, true);
+  const BitSet zeros(bits, false);
+  runner.run("count", IMPL, bits, [&] { do_not_optimize(rhs.count()); });
+  runner.run("all", IMPL, bits, [&] { do_not_optimize(ones.all()); });
+  runner.run("any", IMPL, bits, [&] { do_not_optimize(zeros.any()); });
+  runner.run("flip_count", IMPL, bits, [&] { do_not_optimize(lhs.flip().count()); });
+  ComplementBitSet complement(lhs);
+  runner.run("flip_count", "ct::ComplementBitSet", bits, [&] { do_not_optimize(complement.flip().count()); });
+  runner.run("and_not", IMPL, bits, [&] { lhs &= ~rhs; });
+  const ComplementBitSet rhs_complement(rhs);
+  runner.run("and_not", "ct::ComplementBitSet", bits, [&] { complement &= ~rhs_complement; });
+
+  // A mostly full free-space map: long runs of ones, and no run of a word of zeros for `find_run` to stop at
+  BitSet extents(bits, false);
+  fill_random(extents, words, 0.99);
+  runner.run("runs", IMPL, bits, [&] {
+    std::size_t sum = 0;
+    for (const BitRun& run : extents.runs()) {
+      sum += run.length;
+    }
+    do_not_optimize(sum);
+  });
+  runner.run("find_run", IMPL, bits, [&] { do_not_optimize(extents.find_run(detail::WORD_BITS)); });
+
+  runner.run("iterate", IMPL, bits, [&] {
+    std::size_t sum = 0;
+    for (bool bit : rhs) {
+      sum += bit;
+    }
+    do_not_optimize(sum);
+  });
+  runner.run("random_access", IMPL, bits, [&] {
+    std::size_t sum = 0;
+    for (std::size_t index : indices) {
+      sum += rhs[index];
+    }
+    do_not_optimize(sum);
+  });
+  BitSet huge(bits, false, HUGE_PAGES);
+  huge |= rhs;
+  runner.run("random_access", "ct::BitSet with huge pages", bits, [&] {
+    std::size_t sum = 0;
+    for (std::size_t index : indices) {
+      sum += huge[index];
+    }
+    do_not_optimize(sum);
+  });
+  runner.run("count", "ct::BitSet with huge pages", bits, [&] { do_not_optimize(huge.count()); });
+  runner.run("random_set", IMPL, bits, [&] {
+    for (std::size_t index : indices) {
+      lhs[index] = true;
+    }
+  });
+  runner.run("random_set_batch", IMPL, bits, [&] { lhs.set_bits(indices); });
+  std::unique_ptr<bool[]> tested = std::make_unique<bool[]>(indices.size());
+  runner.run("random_test_batch", IMPL, bits, [&] {
+    rhs.test_bits(indices, std::span(tested.get(), indices.size()));
+    do_not_optimize(tested);
+  });
+
+  std::vector<std::uint64_t> positions;
+  rhs.append_indices(positions);
+  runner.run("to_indices", IMPL, bits, [&] {
+    positions.clear();
+    rhs.append_indices(positions);
+    do_not_optimize(positions);
+  });
+  runner.run("from_indices", IMPL, bits, [&] { do_not_optimize(BitSet::from_indices(positions, bits)); });
+  BitWriter writer;
+  runner.run("write_fields", "ct::BitWriter", bits, [&] {
+    writer.clear();
+    for (std::size_t i = 0; i + FIELD_BITS <= bits; i += FIELD_BITS) {
+      writer.write(i, FIELD_BITS);
+    }
+    do_not_optimize(writer);
+  });
+  runner.run("read_fields", "ct::BitReader", bits, [&] {
+    BitReader reader(rhs);
+    BitSet::Word sum = 0;
+    while (reader.remaining() >= FIELD_BITS) {
+      sum += reader.read(FIELD_BITS);
+    }
+    do_not_optimize(sum);
+  });
+  runner.run("read_unary", "ct::BitReader", bits, [&] {
+    BitReader reader(rhs);
+    std::size_t sum = 0;
+    while (reader.remaining() != 0) {
+      sum += reader.read_unary();
+    }
+    do_not_optimize(sum);
+  });
+  runner.run("extract", IMPL, bits, [&] { do_not_optimize(extract(lhs, rhs)); });
+  runner.run("deposit", IMPL, bits, [&] { deposit(rhs, rhs, lhs); });
+
+  if (bits > 2 * detail::WORD_BITS) {
+    std::size_t length = bits - 2 * detail::WORD_BITS;
+    runner.run("subview_and_aligned", IMPL, bits, [&] {
+      lhs.subview(detail::WORD_BITS, length) &= rhs.subview(0, length);
+    });
+
+    // The same aligned ranges through views that are built once, general and aligned by type
+    BitSet::View view = lhs.subview(detail::WORD_BITS, length);
+    BitSet::ConstView other = rhs.subview(0, length);
+    BitSet::AlignedView aligned = *lhs.subview_aligned(detail::WORD_BITS, length);
+    BitSet::AlignedConstView aligned_other = *rhs.subview_aligned(0, length);
+    runner.run("view_and", "ct::BitSet::View", bits, [&] { view &= other; });
+    runner.run("view_and", "ct::BitSet::AlignedView", bits, [&] { aligned &= aligned_other; });
+    runner.run("view_count", "ct::BitSet::View", bits, [&] { do_not_optimize(view.count()); });
+    runner.run("view_count", "ct::BitSet::AlignedView", bits, [&] { do_not_optimize(aligned.count()); });
+    runner.run("view_equal", "ct::BitSet::View", bits, [&] { do_not_optimize(view == other); });
+    runner.run("view_equal", "ct::BitSet::AlignedView", bits, [&] { do_not_optimize(aligned == aligned_other); });
+
+    runner.run("subview_and_misaligned", IMPL, bits, [&] { lhs.subview(3, length) &= rhs.subview(5, length); });
+    runner.run("subview_count_misaligned", IMPL, bits, [&] { do_not_optimize(rhs.subview(3, length).count()); });
+
+    BitSet shifted(bits + 2, false);
+    shifted.subview(2) |= rhs;
+    runner.run("subview_equal_misaligned", IMPL, bits, [&] {
+      do_not_optimize(shifted.subview(5, length) == rhs.subview(3, length));
+    });
+  }
+}
+
+void run_vector_bool(Runner& runner, std::size_t bits) {
+  constexpr std::string_view IMPL = "std::vector<bool>";
+  std::mt19937_64 rng(SEED);
+  std::vector<bool> lhs = to_vector(random_bitset(bits, rng));
+  const std::vector<bool> rhs = to_vector(random_bitset(bits, rng));
+  std::vector<std::size_t> indices = random_indices(bits, rng);
+
+  runner.run("construct", IMPL, bits, [&] { do_not_optimize(std::vector<bool>(bits, true)); });
+  if (bits <= MAX_STRING_BITS) {
+    std::string str(bits, '0');
+    std::ranges::transform(lhs, str.begin(), [](bool bit) { return bit ? '1' : '0'; });
+    runner.run("parse", IMPL, bits, [&] {
+      std::vector<bool> result(str.size());
+      for (std::size_t i = 0; i < str.size(); ++i) {
+        result[i] = (str[i] == '1');
+      }
+      do_not_optimize(result);
+    });
+    runner.run("print", IMPL, bits, [&] {
+      std::string result(bits, '0');
+      std::ranges::transform(lhs, result.begin(), [](bool bit) { return bit ? '1' : '0'; });
+      do_not_optimize(result);
+    });
+  }
+
+  runner.run("push_back", IMPL, bits, [&] {
+    std::vector<bool> result;
+    for (std::size_t i = 0; i < bits; ++i) {
+      result.push_back(i % 3 == 0);
+    }
+    do_not_optimize(result);
+  });
+  runner.run("append", IMPL, bits, [&] {
+    std::vector<bool> result;
+    for (std::size_t i = 0; i + FIELD_BITS <= bits; i += FIELD_BITS) {
+      result.insert(result.end(), rhs.begin() + i, rhs.begin() + i + FIELD_BITS);
+    }
+    do_not_optimize(result);
+  });
+
+  runner.run("and", IMPL, bits, [&] {
+    for (std::size_t i = 0; i < bits; ++i) {
+      lhs[i] = lhs[i] && rhs[i];
+    }
+  });
+  runner.run("or", IMPL, bits, [&] {
+    for (std::size_t i = 0; i < bits; ++i) {
+      lhs[i] = lhs[i] || rhs[i];
+    }
+  });
+  runner.run("xor", IMPL, bits, [&] {
+    for (std::size_t i = 0; i < bits; ++i) {
+      lhs[i] = lhs[i] != rhs[i];
+    }
+  });
+  runner.run("flip", IMPL, bits, [&] { lhs.flip(); });
+  runner.run("shift_left", IMPL, bits, [&] {
+    std::vector<bool> result = rhs;
+    result.resize(bits + SHIFT, false);
+    do_not_optimize(result);
+  });
+  runner.run("shift_right", IMPL, bits, [&] {
+    do_not_optimize(std::vector<bool>(rhs.begin(), rhs.end() - static_cast<std::ptrdiff_t>(std::min(SHIFT, bits))));
+  });
+  runner.run("shift_in_place", IMPL, bits, [&] {
+    auto shift = static_cast<std::ptrdiff_t>(std::min(SHIFT, bits));
+    std::fill(std::copy(lhs.begin() + shift, lhs.end(), lhs.begin()), lhs.end(), false);
+  });
+  runner.run("rotate", IMPL, bits, [&] {
+    std::rotate(lhs.begin(), lhs.begin() + static_cast<std::ptrdiff_t>(bits / 3), lhs.end());
+  });
+  std::bernoulli_distribution half(0.5);
+  std::bernoulli_distribution tenth(0.1);
+  runner.run("fill_random_half", IMPL, bits, [&] {
+    for (std::size_t i = 0; i < bits; ++i) {
+      lhs[i] = half(rng);
+    }
+  });
+  runner.run("fill_random_tenth", IMPL, bits, [&] {
+    for (std::size_t i = 0; i < bits; ++i) {
+      lhs[i] = tenth(rng);
+    }
+  });
+  runner.run("reverse", IMPL, bits, [&] { std::reverse(lhs.begin(), lhs.end()); });
+  runner.run("reversed_copy", IMPL, bits, [&] { do_not_optimize(std::vector<bool>(rhs.rbegin(), rhs.rend())); });
+
+  const std::vector<bool> ones(bits, true);
+  const std::vector<bool> zeros(bits, false);
+  runner.run("count", IMPL, bits, [&] { do_not_optimize(std::ranges::count(rhs, true)); });
+  runner.run("all", IMPL, bits, [&] { do_not_optimize(std::ranges::find(ones, false) == ones.end()); });
+  runner.run("any", IMPL, bits, [&] { do_not_optimize(std::ranges::find(zeros, true) != zeros.end()); });
+
+  runner.run("iterate", IMPL, bits, [&] {
+    std::size_t sum = 0;
+    for (bool bit : rhs) {
+      sum += bit;
+    }
+    do_not_optimize(sum);
+  });
+  runner.run("random_access", IMPL, bits, [&] {
+    std::size_t sum = 0;
+    for (std::size_t index : indices) {
+      sum += rhs[index];
+    }
+    do_not_optimize(sum);
+  });
+  runner.run("random_set", IMPL, bits, [&] {
+    for (std::size_t index : indices) {
+      lhs[index] = true;
+    }
+  });
+
+  std::vector<std::uint64_t> positions;
+  runner.run("to_indices", IMPL, bits, [&] {
+    positions.clear();
+    for (std::size_t i = 0; i < bits; ++i) {
+      if (rhs[i]) {
+        positions.push_back(i);
+      }
+    }
+    do_not_optimize(positions);
+  });
+  runner.run("from_indices", IMPL, bits, [&] {
+    std::vector<bool> result(bits);
+    for (std::uint64_t position : positions) {
+      result[position] = true;
+    }
+    do_not_optimize(result);
+  });
+  runner.run("extract", IMPL, bits, [&] {
+    std::vector<bool> result;
+    for (std::size_t i = 0; i < bits; ++i) {
+      if (rhs[i]) {
+        result.push_back(lhs[i]);
+      }
+    }
+    do_not_optimize(result);
+  });
+  runner.run("deposit", IMPL, bits, [&] {
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < bits; ++i) {
+      if (rhs[i]) {
+        lhs[i] = rhs[next++];
+      }
+    }
+  });
+}
+
+// `std::bitset` keeps its size; shifts are measured as in-place size-preserving shifts of a preallocated copy.
+// Objects live on the heap since the larger sizes don't fit on the stack.
+template <std::size_t N>
+void run_std_bitset(Runner& runner) {
+  constexpr std::string_view IMPL = "std::bitset";
+  using Bits = std::bitset<N>;
+  std::mt19937_64 rng(SEED);
+  auto make = [&] {
+    auto result = std::make_unique<Bits>();
+    BitSet source = random_bitset(N, rng);
+    for (std::size_t i = 0; i < N; ++i) {
+      (*result)[i] = source[i];
+    }
+    return result;
+  };
+  std::unique_ptr<Bits> lhs = make();
+  const std::unique_ptr<Bits> rhs = make();
+  std::unique_ptr<Bits> result = std::make_unique<Bits>();
+  std::vector<std::size_t> indices = random_indices(N, rng);
+
+  runner.run("construct", IMPL, N, [&] {
+    auto bits = std::make_unique<Bits>();
+    bits->set();
+    do_not_optimize(bits);
+  });
+  if constexpr (N <= MAX_STRING_BITS) {
+    std::string str = lhs->to_string();
+    runner.run("parse", IMPL, N, [&] {
+      *result = Bits(str);
+      do_not_optimize(result);
+    });
+    runner.run("print", IMPL, N, [&] { do_not_optimize(lhs->to_string()); });
+  }
+
+  runner.run("and", IMPL, N, [&] { *lhs &= *rhs; });
+  runner.run("or", IMPL, N, [&] { *lhs |= *rhs; });
+  runner.run("xor", IMPL, N, [&] { *lhs ^= *rhs; });
+  runner.run("flip", IMPL, N, [&] { lhs->flip(); });
+  runner.run("shift_left", IMPL, N, [&] {
+    *result = *rhs;
+    *result <<= SHIFT;
+    do_not_optimize(result);
+  });
+  runner.run("shift_right", IMPL, N, [&] {
+    *result = *rhs;
+    *result >>= SHIFT;
+    do_not_optimize(result);
+  });
+
+  std::unique_ptr<Bits> ones = std::make_unique<Bits>();
+  ones->set();
+  std::unique_ptr<Bits> zeros = std::make_unique<Bits>();
+  runner.run("count", IMPL, N, [&] { do_not_optimize(rhs->count()); });
+  runner.run("all", IMPL, N, [&] { do_not_optimize(ones->all()); });
+  runner.run("any", IMPL, N, [&] { do_not_optimize(zeros->any()); });
+
+  runner.run("iterate", IMPL, N, [&] {
+    std::size_t sum = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+      sum += (*rhs)[i];
+    }
+    do_not_optimize(sum);
+  });
+  runner.run("random_access", IMPL, N, [&] {
+    std::size_t sum = 0;
+    for (std::size_t index : indices) {
+      sum += (*rhs)[index];
+    }
+    do_not_optimize(sum);
+  });
+}
+
+template <std::size_t... Is>
+void run_std_bitsets(Runner& runner, std::index_sequence<Is...>) {
+  ((runner.enabled(SIZES[Is]) ? run_std_bitset<SIZES[Is]>(runner) : void()), ...);
+}
+
+} // namespace
+
+void run_bitset_benchmarks(Runner& runner) {
+  for (std::size_t bits : SIZES) {
+    if (runner.enabled(bits)) {
+      run_ct_bitset(runner, bits);
+      run_vector_bool(runner, bits);
+    }
+  }
+  run_std_bitsets(runner, std::make_index_sequence<SIZES.size()>());
+}
+
+} // namespace ct::bench
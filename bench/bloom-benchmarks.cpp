@@ -0,0 +1,102 @@
+#include "benchmark.h"
+#include "bitset-bloom.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace ct::bench {
+
+namespace {
+
+constexpr std::array<std::size_t, 3> SIZES = {std::size_t(1) << 18, std::size_t(1) << 24, std::size_t(1) << 30};
+constexpr std::size_t KEYS = 4096;
+constexpr std::size_t PROBES = 8;
+constexpr std::uint64_t SEED = 42;
+
+// The usual construction on top of a plain bitset: every probe lands in an independent position
+class NaiveBloomFilter {
+public:
+  explicit NaiveBloomFilter(std::size_t bits)
+      : _bits(bits, false) {}
+
+  void insert(std::uint64_t hash) {
+    for (std::size_t i = 0; i < PROBES; ++i) {
+      _bits[position(hash, i)] = true;
+    }
+  }
+
+  bool contains(std::uint64_t hash) const {
+    for (std::size_t i = 0; i < PROBES; ++i) {
+      if (!_bits[position(hash, i)]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  // Double hashing, mapped onto the range by multiplication
+  std::size_t position(std::uint64_t hash, std::size_t i) const {
+    auto probe = static_cast<std::uint32_t>((hash >> 32) + i * (hash | 1));
+    return static_cast<std::size_t>((std::uint64_t(probe) * _bits.size()) >> 32);
+  }
+
+private:
+  BitSet _bits;
+};
+
+} // namespace
+
+void run_bloom_benchmarks(Runner& runner) {
+  for (std::size_t bits : SIZES) {
+    if (!runner.enabled(bits)) {
+      continue;
+    }
+    std::mt19937_64 rng(SEED);
+    std::vector<std::uint64_t> keys(KEYS);
+    for (std::uint64_t& key : keys) {
+      key = rng();
+    }
+    std::unique_ptr<bool[]> found = std::make_unique<bool[]>(KEYS);
+
+    BlockedBloomFilter blocked(bits);
+    runner.run("bloom_insert", "ct::BlockedBloomFilter", bits, [&] {
+      for (std::uint64_t key : keys) {
+        blocked.insert(key);
+      }
+    });
+    runner.run("bloom_insert_batch", "ct::BlockedBloomFilter", bits, [&] { blocked.insert(keys); });
+    runner.run("bloom_contains", "ct::BlockedBloomFilter", bits, [&] {
+      std::size_t hits = 0;
+      for (std::uint64_t key : keys) {
+        hits += blocked.contains(key);
+      }
+      do_not_optimize(hits);
+    });
+    runner.run("bloom_contains_batch", "ct::BlockedBloomFilter", bits, [&] {
+      blocked.contains(keys, std::span(found.get(), KEYS));
+      do_not_optimize(found);
+    });
+
+    NaiveBloomFilter naive(bits);
+    runner.run("bloom_insert", "naive over BitSet", bits, [&] {
+      for (std::uint64_t key : keys) {
+        naive.insert(key);
+      }
+    });
+    runner.run("bloom_contains", "naive over BitSet", bits, [&] {
+      std::size_t hits = 0;
+      for (std::uint64_t key : keys) {
+        hits += naive.contains(key);
+      }
+      do_not_optimize(hits);
+    });
+  }
+}
+
+} // namespace ct::bench
@@ -0,0 +1,20 @@
+#include "benchmark.h"
+
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char** argv) {
+  ct::bench::Runner runner(ct::bench::parse_options(argc, argv));
+
+  ct::bench::run_bitset_benchmarks(runner);
+  ct::bench::run_matrix_benchmarks(runner);
+  ct::bench::run_bloom_benchmarks(runner);
+  ct::bench::run_reduce_benchmarks(runner);
+  ct::bench::run_bfs_benchmarks(runner);
+
+  runner.print_table(std::cout);
+  if (!runner.options().json_path.empty()) {
+    std::ofstream out(runner.options().json_path);
+    runner.write_json(out);
+  }
+}
@@ -0,0 +1,111 @@
+#include "benchmark.h"
+#include "bitset-matrix.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace ct::bench {
+
+namespace {
+
+// Square matrices; the reported size is the number of elements
+constexpr std::array<std::size_t, 3> SIZES = {64, 512, 4096};
+constexpr std::uint64_t SEED = 42;
+
+using Rows = std::vector<BitSet>;
+
+BitMatrix random_matrix(std::size_t size, std::mt19937_64& rng) {
+  BitMatrix result(size, size, false);
+  for (std::size_t i = 0; i < size; ++i) {
+    BitSet::View row = result[i];
+    std::generate_n(row.data(), detail::word_count(size), std::ref(rng));
+  }
+  return result;
+}
+
+Rows to_rows(const BitMatrix& matrix) {
+  Rows result;
+  result.reserve(matrix.rows());
+  for (std::size_t i = 0; i < matrix.rows(); ++i) {
+    result.emplace_back(matrix[i]);
+  }
+  return result;
+}
+
+Rows naive_transpose(const Rows& rows) {
+  Rows result(rows[0].size(), BitSet(rows.size(), false));
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    for (std::size_t j = 0; j < rows[i].size(); ++j) {
+      result[j][i] = rows[i][j];
+    }
+  }
+  return result;
+}
+
+// Row-by-row product: every set element of `left` adds a row of `right`
+Rows naive_multiply(const Rows& left, const Rows& right) {
+  Rows result(left.size(), BitSet(right[0].size(), false));
+  for (std::size_t i = 0; i < left.size(); ++i) {
+    for (std::size_t k = 0; k < right.size(); ++k) {
+      if (left[i][k]) {
+        result[i] ^= right[k];
+      }
+    }
+  }
+  return result;
+}
+
+std::size_t naive_rank(Rows rows) {
+  std::size_t rank = 0;
+  for (std::size_t column = 0; column < rows[0].size() && rank < rows.size(); ++column) {
+    std::size_t pivot = rank;
+    while (pivot < rows.size() && !rows[pivot][column]) {
+      ++pivot;
+    }
+    if (pivot == rows.size()) {
+      continue;
+    }
+    rows[pivot].swap(rows[rank]);
+    for (std::size_t row = 0; row < rows.size(); ++row) {
+      if (row != rank && rows[row][column]) {
+        rows[row] ^= rows[rank];
+      }
+    }
+    ++rank;
+  }
+  return rank;
+}
+
+} // namespace
+
+void run_matrix_benchmarks(Runner& runner) {
+  for (std::size_t size : SIZES) {
+    std::size_t elements = size * size;
+    if (!runner.enabled(elements)) {
+      continue;
+    }
+    std::mt19937_64 rng(SEED);
+    const BitMatrix left = random_matrix(size, rng);
+    const BitMatrix right = random_matrix(size, rng);
+    const Rows left_rows = to_rows(left);
+    const Rows right_rows = to_rows(right);
+
+    runner.run("matrix_transpose", "ct::BitMatrix", elements, [&] { do_not_optimize(left.transposed()); });
+    runner.run("matrix_transpose", "std::vector<BitSet>", elements, [&] {
+      do_not_optimize(naive_transpose(left_rows));
+    });
+    runner.run("matrix_multiply", "ct::BitMatrix", elements, [&] { do_not_optimize(left * right); });
+    runner.run("matrix_multiply", "std::vector<BitSet>", elements, [&] {
+      do_not_optimize(naive_multiply(left_rows, right_rows));
+    });
+    runner.run("matrix_rank", "ct::BitMatrix", elements, [&] { do_not_optimize(left.rank()); });
+    runner.run("matrix_rank", "std::vector<BitSet>", elements, [&] { do_not_optimize(naive_rank(left_rows)); });
+  }
+}
+
+} // namespace ct::bench
@@ -0,0 +1,74 @@
+#include "benchmark.h"
+#include "bitset-reduce.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ct::bench {
+
+namespace {
+
+constexpr std::size_t BITS = std::size_t(1) << 22;
+constexpr std::array<std::size_t, 3> INPUTS = {4, 32, 256};
+constexpr std::uint64_t SEED = 42;
+
+// Dense random inputs, so that AND of a few of them does not become zero early
+BitSet dense_bitset(std::size_t bits, std::mt19937_64& rng) {
+  BitSet result(bits, false);
+  BitSet::View view = result;
+  std::generate_n(view.data(), detail::word_count(bits), [&] { return rng() | rng() | rng(); });
+  return result;
+}
+
+std::string benchmark_name(std::string_view operation, std::size_t inputs) {
+  std::string result(operation);
+  result += '_';
+  result += std::to_string(inputs);
+  return result;
+}
+
+} // namespace
+
+void run_reduce_benchmarks(Runner& runner) {
+  if (!runner.enabled(BITS)) {
+    return;
+  }
+  for (std::size_t inputs : INPUTS) {
+    std::mt19937_64 rng(SEED);
+    std::vector<BitSet> bitsets;
+    std::vector<BitSet::ConstView> views;
+    for (std::size_t i = 0; i < inputs; ++i) {
+      bitsets.push_back(dense_bitset(BITS, rng));
+    }
+    views.assign(bitsets.begin(), bitsets.end());
+
+    runner.run(benchmark_name("and_all", inputs), "fused", BITS, [&] { do_not_optimize(and_all(views)); });
+    runner.run(benchmark_name("and_all", inputs), "pairwise", BITS, [&] {
+      BitSet result = bitsets[0];
+      for (std::size_t i = 1; i < inputs; ++i) {
+        result &= bitsets[i];
+      }
+      do_not_optimize(result);
+    });
+    runner.run(benchmark_name("count_or_all", inputs), "fused", BITS, [&] { do_not_optimize(count_or_all(views)); });
+    runner.run(benchmark_name("count_or_all", inputs), "pairwise", BITS, [&] {
+      BitSet result = bitsets[0];
+      for (std::size_t i = 1; i < inputs; ++i) {
+        result |= bitsets[i];
+      }
+      do_not_optimize(result.count());
+    });
+    runner.run(benchmark_name("threshold_count", inputs), "fused", BITS, [&] {
+      do_not_optimize(threshold_count(views, inputs / 2));
+    });
+  }
+}
+
+} // namespace ct::bench
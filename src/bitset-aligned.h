@@ -0,0 +1,244 @@
+#pragma once
+
+#include "bitset-view.h"
+#include "bitset-words.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+namespace ct {
+
+// View whose first bit is the most significant bit of a storage word. The alignment is part of the type, so bulk
+// operations with other aligned views are plain loops over whole words, with a mask for the last partial word only.
+// Converts implicitly to the general views, which accept it everywhere else. Obtained with `subview_aligned`, which
+// checks the alignment.
+template <typename W>
+class AlignedBitView {
+public:
+  using Word = std::remove_const_t<W>;
+  using Reference = BitReference<W>;
+  using View = BitView<W>;
+  using ConstView = BitView<const Word>;
+  using AlignedView = AlignedBitView<W>;
+  using AlignedConstView = AlignedBitView<const Word>;
+
+  static constexpr std::size_t NPOS = -1;
+
+  AlignedBitView() = default;
+
+  // View of the first `size` bits of the words
+  explicit AlignedBitView(std::span<W> words, std::size_t size = NPOS)
+      : _data(words.data())
+      , _size(std::min(size, words.size() * detail::WORD_BITS)) {}
+
+  template <typename U>
+  AlignedBitView(const AlignedBitView<U>& other)
+    requires (std::is_const_v<W> && !std::is_const_v<U>)
+      : _data(other.data())
+      , _size(other.size()) {}
+
+  operator View() const {
+    return View(_data, 0, _size);
+  }
+
+  operator ConstView() const
+    requires (!std::is_const_v<W>)
+  {
+    return ConstView(_data, 0, _size);
+  }
+
+  std::size_t size() const {
+    return _size;
+  }
+
+  bool empty() const {
+    return _size == 0;
+  }
+
+  Reference operator[](std::size_t index) const {
+    return View(*this)[index];
+  }
+
+  W* data() const {
+    return _data;
+  }
+
+  bool all() const {
+    return for_each_word([](Word word, Word mask) { return (word & mask) == mask; });
+  }
+
+  bool any() const {
+    return !for_each_word([](Word word, Word mask) { return (word & mask) == 0; });
+  }
+
+  std::size_t count() const {
+    std::size_t result = 0;
+    for_each_word([&result](Word word, Word mask) {
+      result += static_cast<std::size_t>(std::popcount(word & mask));
+      return true;
+    });
+    return result;
+  }
+
+  const AlignedBitView& set() const
+    requires (!std::is_const_v<W>)
+  {
+    return assign(detail::Kernel::SCAN, [](Word, std::size_t) { return detail::ALL_ONES; });
+  }
+
+  const AlignedBitView& reset() const
+    requires (!std::is_const_v<W>)
+  {
+    return assign(detail::Kernel::SCAN, [](Word, std::size_t) { return Word(0); });
+  }
+
+  const AlignedBitView& flip() const
+    requires (!std::is_const_v<W>)
+  {
+    return assign(detail::Kernel::SCAN, [](Word word, std::size_t) { return ~word; });
+  }
+
+  // The views must have the same size, and either coincide or not overlap. These are templates so that aligned
+  // operands take them rather than a conversion to the general overloads.
+  template <typename U>
+  const AlignedBitView& operator&=(const AlignedBitView<U>& other) const
+    requires (!std::is_const_v<W>)
+  {
+    return combine(other, std::bit_and<>());
+  }
+
+  template <typename U>
+  const AlignedBitView& operator|=(const AlignedBitView<U>& other) const
+    requires (!std::is_const_v<W>)
+  {
+    return combine(other, std::bit_or<>());
+  }
+
+  template <typename U>
+  const AlignedBitView& operator^=(const AlignedBitView<U>& other) const
+    requires (!std::is_const_v<W>)
+  {
+    return combine(other, std::bit_xor<>());
+  }
+
+  const AlignedBitView& operator&=(const ConstView& other) const
+    requires (!std::is_const_v<W>)
+  {
+    View(*this) &= other;
+    return *this;
+  }
+
+  const AlignedBitView& operator|=(const ConstView& other) const
+    requires (!std::is_const_v<W>)
+  {
+    View(*this) |= other;
+    return *this;
+  }
+
+  const AlignedBitView& operator^=(const ConstView& other) const
+    requires (!std::is_const_v<W>)
+  {
+    View(*this) ^= other;
+    return *this;
+  }
+
+  // Aligned subview, or nothing if `offset` is not a multiple of the word width
+  std::optional<AlignedBitView> subview_aligned(std::size_t offset = 0, std::size_t count = NPOS) const {
+    if (offset % detail::WORD_BITS != 0) {
+      return std::nullopt;
+    }
+    offset = std::min(offset, _size);
+    return AlignedBitView(_data + offset / detail::WORD_BITS, std::min(count, _size - offset));
+  }
+
+  View subview(std::size_t offset = 0, std::size_t count = NPOS) const {
+    return View(*this).subview(offset, count);
+  }
+
+private:
+  AlignedBitView(W* data, std::size_t size)
+      : _data(data)
+      , _size(size) {}
+
+  // Calls `visit(word, mask)` for every word of the view until it returns `false`
+  template <typename F>
+  bool for_each_word(F visit) const {
+    std::size_t full_words = _size / detail::WORD_BITS;
+    std::size_t rest = _size % detail::WORD_BITS;
+    for (std::size_t i = 0; i < full_words; ++i) {
+      if (!visit(_data[i], detail::ALL_ONES)) {
+        detail::record_words(detail::Kernel::SCAN, i + 1, 0, 0);
+        return false;
+      }
+    }
+    detail::record_words(detail::Kernel::SCAN, full_words, 0, rest != 0);
+    return rest == 0 || visit(_data[full_words], detail::range_mask(0, rest));
+  }
+
+  // Replaces every word `w` of the view with `op(w, i)`, where `i` is its index, keeping the bits past the end
+  template <typename Op>
+  const AlignedBitView& assign(detail::Kernel kernel, Op op) const {
+    W* data = _data;
+    std::size_t full_words = _size / detail::WORD_BITS;
+    std::size_t rest = _size % detail::WORD_BITS;
+    detail::record_words(kernel, full_words, 0, rest != 0);
+    for (std::size_t i = 0; i < full_words; ++i) {
+      data[i] = op(data[i], i);
+    }
+    if (rest != 0) {
+      Word mask = detail::range_mask(0, rest);
+      data[full_words] = (data[full_words] & ~mask) | (op(data[full_words], full_words) & mask);
+    }
+    return *this;
+  }
+
+  template <typename Op>
+  const AlignedBitView& combine(const AlignedConstView& other, Op op) const {
+    const Word* source = other.data();
+    return assign(detail::Kernel::TRANSFORM, [source, op](Word word, std::size_t i) { return op(word, source[i]); });
+  }
+
+private:
+  W* _data = nullptr;
+  std::size_t _size = 0;
+
+  template <typename>
+  friend class AlignedBitView;
+
+  friend class BitSet;
+};
+
+template <typename L, typename R>
+bool operator==(const AlignedBitView<L>& lhs, const AlignedBitView<R>& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  std::size_t full_words = lhs.size() / detail::WORD_BITS;
+  std::size_t rest = lhs.size() % detail::WORD_BITS;
+  detail::record_words(detail::Kernel::COMPARE, full_words, 0, rest != 0);
+  if (!std::equal(lhs.data(), lhs.data() + full_words, rhs.data())) {
+    return false;
+  }
+  return rest == 0 || ((lhs.data()[full_words] ^ rhs.data()[full_words]) & detail::range_mask(0, rest)) == 0;
+}
+
+// Subview of `view` as an aligned view, or nothing if the subview does not start at a word boundary
+template <typename W>
+std::optional<AlignedBitView<W>> subview_aligned(
+    const BitView<W>& view,
+    std::size_t offset = 0,
+    std::size_t count = BitView<W>::NPOS
+) {
+  if ((view.offset() + offset) % detail::WORD_BITS != 0) {
+    return std::nullopt;
+  }
+  BitView<W> result = view.subview(offset, count);
+  return AlignedBitView<W>(std::span<W>(result.data(), detail::word_count(result.size())), result.size());
+}
+
+} // namespace ct
@@ -0,0 +1,148 @@
+#include "bitset-batch.h"
+
+#include <vector>
+
+namespace ct::detail {
+
+namespace {
+
+// How many positions ahead the storage word is prefetched
+constexpr std::size_t PREFETCH_DISTANCE = 16;
+
+// Updates are grouped by regions of 2^21 bits (256 KiB of storage) when both the batch and the storage are large
+// enough for cache misses to dominate the cost of a counting sort
+constexpr std::size_t REGION_BITS_LOG2 = 21;
+constexpr std::size_t MIN_GROUPED_BATCH = std::size_t(1) << 16;
+constexpr std::size_t MIN_GROUPED_BITS = std::size_t(1) << 26;
+
+struct SetBits {
+  static Word combine(Word mask, Word bit) {
+    return mask | bit;
+  }
+
+  static void apply(Word& word, Word mask) {
+    word |= mask;
+  }
+};
+
+struct ResetBits {
+  static Word combine(Word mask, Word bit) {
+    return mask | bit;
+  }
+
+  static void apply(Word& word, Word mask) {
+    word &= ~mask;
+  }
+};
+
+// Flipping a bit twice must cancel out, so flips of one word are combined with xor
+struct FlipBits {
+  static Word combine(Word mask, Word bit) {
+    return mask ^ bit;
+  }
+
+  static void apply(Word& word, Word mask) {
+    word ^= mask;
+  }
+};
+
+// Applies the update, merging consecutive positions that fall into the same word into a single read-modify-write
+template <typename Update>
+void update_sequence(Word* data, std::size_t offset, std::span<const std::size_t> indices) {
+  std::size_t i = 0;
+  while (i < indices.size()) {
+    if (i + PREFETCH_DISTANCE < indices.size()) {
+      prefetch(data + (offset + indices[i + PREFETCH_DISTANCE]) / WORD_BITS);
+    }
+    std::size_t word = (offset + indices[i]) / WORD_BITS;
+    Word mask = bit_mask((offset + indices[i]) % WORD_BITS);
+    for (++i; i < indices.size() && (offset + indices[i]) / WORD_BITS == word; ++i) {
+      mask = Update::combine(mask, bit_mask((offset + indices[i]) % WORD_BITS));
+    }
+    Update::apply(data[word], mask);
+  }
+}
+
+// Counting sort of the positions by storage region, so that each region is updated while it is cached
+std::vector<std::size_t> group_by_region(std::size_t offset, std::size_t size, std::span<const std::size_t> indices) {
+  std::size_t regions = ((offset + size) >> REGION_BITS_LOG2) + 1;
+  std::vector<std::size_t> starts(regions + 1);
+  for (std::size_t index : indices) {
+    ++starts[((offset + index) >> REGION_BITS_LOG2) + 1];
+  }
+  for (std::size_t i = 1; i <= regions; ++i) {
+    starts[i] += starts[i - 1];
+  }
+  std::vector<std::size_t> result(indices.size());
+  for (std::size_t index : indices) {
+    result[starts[(offset + index) >> REGION_BITS_LOG2]++] = index;
+  }
+  return result;
+}
+
+template <typename Update>
+void apply_update(Word* data, std::size_t offset, std::size_t size, std::span<const std::size_t> indices) {
+  if (indices.size() >= MIN_GROUPED_BATCH && size >= MIN_GROUPED_BITS) {
+    std::vector<std::size_t> grouped = group_by_region(offset, size, indices);
+    update_sequence<Update>(data, offset, grouped);
+  } else {
+    update_sequence<Update>(data, offset, indices);
+  }
+}
+
+bool test_bit(const Word* data, std::size_t position) {
+  return (data[position / WORD_BITS] & bit_mask(position % WORD_BITS)) != 0;
+}
+
+} // namespace
+
+void update_bits(
+    Word* data,
+    std::size_t offset,
+    std::size_t size,
+    std::span<const std::size_t> indices,
+    BitUpdate update
+) {
+  switch (update) {
+  case BitUpdate::SET:
+    apply_update<SetBits>(data, offset, size, indices);
+    break;
+  case BitUpdate::RESET:
+    apply_update<ResetBits>(data, offset, size, indices);
+    break;
+  case BitUpdate::FLIP:
+    apply_update<FlipBits>(data, offset, size, indices);
+    break;
+  }
+}
+
+void test_bits(const Word* data, std::size_t offset, std::span<const std::size_t> indices, std::span<bool> out) {
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    if (i + PREFETCH_DISTANCE < indices.size()) {
+      prefetch(data + (offset + indices[i + PREFETCH_DISTANCE]) / WORD_BITS);
+    }
+    out[i] = test_bit(data, offset + indices[i]);
+  }
+}
+
+void test_bits(
+    const Word* data,
+    std::size_t offset,
+    std::span<const std::size_t> indices,
+    Word* out_data,
+    std::size_t out_offset
+) {
+  for (std::size_t first = 0; first < indices.size(); first += WORD_BITS) {
+    std::size_t count = std::min(WORD_BITS, indices.size() - first);
+    Word chunk = 0;
+    for (std::size_t i = first; i < first + count; ++i) {
+      if (i + PREFETCH_DISTANCE < indices.size()) {
+        prefetch(data + (offset + indices[i + PREFETCH_DISTANCE]) / WORD_BITS);
+      }
+      chunk |= static_cast<Word>(test_bit(data, offset + indices[i])) << (WORD_BITS - 1 - (i - first));
+    }
+    store_bits(out_data, out_offset + first, count, chunk);
+  }
+}
+
+} // namespace ct::detail
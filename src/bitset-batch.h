@@ -0,0 +1,30 @@
+#pragma once
+
+#include "bitset-words.h"
+
+#include <cstddef>
+#include <span>
+
+// Scatter/gather kernels for many random positions at once. Positions are relative to `data` plus `offset`.
+namespace ct::detail {
+
+enum class BitUpdate : std::uint8_t {
+  SET,
+  RESET,
+  FLIP,
+};
+
+void update_bits(Word* data, std::size_t offset, std::size_t size, std::span<const std::size_t> indices, BitUpdate update);
+
+void test_bits(const Word* data, std::size_t offset, std::span<const std::size_t> indices, std::span<bool> out);
+
+// Writes the tested bits to `out_data` starting at `out_offset`
+void test_bits(
+    const Word* data,
+    std::size_t offset,
+    std::span<const std::size_t> indices,
+    Word* out_data,
+    std::size_t out_offset
+);
+
+} // namespace ct::detail
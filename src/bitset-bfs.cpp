@@ -0,0 +1,223 @@
+#include "bitset-bfs.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <thread>
+
+namespace ct {
+
+namespace {
+
+using detail::Word;
+
+// Smallest amount of work, in queued vertices or bitset words, worth handing to another thread
+constexpr std::size_t MIN_WORK_PER_THREAD = std::size_t(1) << 12;
+
+std::size_t thread_count(std::size_t threads, std::size_t work) {
+  return std::clamp<std::size_t>(work / MIN_WORK_PER_THREAD, 1, threads);
+}
+
+// Calls `body(thread, begin, end)` for `threads` consecutive parts of `[0, count)`, each on its own thread
+template <typename F>
+void parallel_for(std::size_t threads, std::size_t count, F body) {
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (std::size_t thread = 1; thread < threads; ++thread) {
+    workers.emplace_back(body, thread, count * thread / threads, count * (thread + 1) / threads);
+  }
+  body(0, 0, count / threads);
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+
+} // namespace
+
+BreadthFirstSearch::BreadthFirstSearch(const CsrGraph& graph, std::size_t threads)
+    : BreadthFirstSearch(graph, graph, threads) {}
+
+BreadthFirstSearch::BreadthFirstSearch(const CsrGraph& out, const CsrGraph& in, std::size_t threads)
+    : _out(out)
+    , _in(in)
+    , _threads(std::max<std::size_t>(threads, 1))
+    , _visited(out.vertices(), false)
+    , _frontier(out.vertices(), false)
+    , _next(out.vertices(), false)
+    , _next_queues(_threads)
+    , _parents(out.vertices(), NO_PARENT) {}
+
+void BreadthFirstSearch::run(std::uint32_t source) {
+  _visited.reset();
+  std::ranges::fill(_parents, NO_PARENT);
+  _top_down_steps = 0;
+  _bottom_up_steps = 0;
+
+  _visited[source] = true;
+  _parents[source] = source;
+  _queue.assign(1, source);
+  Step frontier{1, _out.degree(source)};
+  std::size_t unexplored_edges = _out.targets.size() - frontier.edges;
+  bool dense = false;
+  bool shrinking = false;
+  while (frontier.vertices != 0) {
+    if (!dense && frontier.edges > unexplored_edges / ALPHA) {
+      queue_to_bitset();
+      dense = true;
+    } else if (dense && shrinking && frontier.vertices < _out.vertices() / BETA) {
+      bitset_to_queue();
+      dense = false;
+    }
+    Step next = dense ? bottom_up() : top_down();
+    shrinking = next.vertices < frontier.vertices;
+    unexplored_edges -= next.edges;
+    frontier = next;
+  }
+}
+
+const BitSet& BreadthFirstSearch::visited() const {
+  return _visited;
+}
+
+std::span<const std::uint32_t> BreadthFirstSearch::parents() const {
+  return _parents;
+}
+
+std::size_t BreadthFirstSearch::top_down_steps() const {
+  return _top_down_steps;
+}
+
+std::size_t BreadthFirstSearch::bottom_up_steps() const {
+  return _bottom_up_steps;
+}
+
+// Every thread collects the vertices it claims into its own queue; they are concatenated into the next frontier
+BreadthFirstSearch::Step BreadthFirstSearch::top_down() {
+  ++_top_down_steps;
+  std::size_t threads = thread_count(_threads, _queue.size());
+  std::vector<Step> steps(threads);
+  Word* visited = BitSet::View(_visited).data();
+  parallel_for(threads, _queue.size(), [&](std::size_t thread, std::size_t begin, std::size_t end) {
+    _next_queues[thread].clear();
+    if (threads == 1) {
+      steps[thread] = top_down_range<false>(begin, end, visited, _next_queues[thread]);
+    } else {
+      steps[thread] = top_down_range<true>(begin, end, visited, _next_queues[thread]);
+    }
+  });
+
+  Step result;
+  _queue.clear();
+  for (std::size_t thread = 0; thread < threads; ++thread) {
+    _queue.insert(_queue.end(), _next_queues[thread].begin(), _next_queues[thread].end());
+    result.vertices += steps[thread].vertices;
+    result.edges += steps[thread].edges;
+  }
+  return result;
+}
+
+// A vertex is claimed by the thread whose OR sets its visited bit. The bit is tested first, so that the common case
+// of a visited neighbour costs no atomic write.
+template <bool ATOMIC>
+BreadthFirstSearch::Step BreadthFirstSearch::top_down_range(
+    std::size_t begin,
+    std::size_t end,
+    Word* visited,
+    std::vector<std::uint32_t>& next
+) {
+  Step result;
+  for (std::size_t i = begin; i < end; ++i) {
+    std::uint32_t vertex = _queue[i];
+    for (std::uint32_t neighbour : _out.neighbours(vertex)) {
+      Word& word = visited[neighbour / detail::WORD_BITS];
+      Word mask = detail::bit_mask(neighbour % detail::WORD_BITS);
+      bool claimed = false;
+      if constexpr (ATOMIC) {
+        std::atomic_ref<Word> shared(word);
+        claimed = (shared.load(std::memory_order_relaxed) & mask) == 0 &&
+                  (shared.fetch_or(mask, std::memory_order_relaxed) & mask) == 0;
+      } else {
+        claimed = (word & mask) == 0;
+        word |= mask;
+      }
+      if (claimed) {
+        _parents[neighbour] = vertex;
+        next.push_back(neighbour);
+        ++result.vertices;
+        result.edges += _out.degree(neighbour);
+      }
+    }
+  }
+  return result;
+}
+
+// Threads own disjoint ranges of words of the visited set and of the next frontier, so no update is shared
+BreadthFirstSearch::Step BreadthFirstSearch::bottom_up() {
+  ++_bottom_up_steps;
+  std::size_t words = detail::word_count(_visited.size());
+  std::size_t threads = thread_count(_threads, words);
+  std::vector<Step> steps(threads);
+  Word* visited = BitSet::View(_visited).data();
+  Word* next = BitSet::View(_next).data();
+  const Word* frontier = BitSet::ConstView(_frontier).data();
+  parallel_for(threads, words, [&](std::size_t thread, std::size_t begin, std::size_t end) {
+    steps[thread] = bottom_up_range(begin, end, visited, next, frontier);
+  });
+  _frontier.swap(_next);
+
+  Step result;
+  for (const Step& step : steps) {
+    result.vertices += step.vertices;
+    result.edges += step.edges;
+  }
+  return result;
+}
+
+// Unvisited vertices are found by scanning the words of the visited set from the most significant bit
+BreadthFirstSearch::Step BreadthFirstSearch::bottom_up_range(
+    std::size_t begin,
+    std::size_t end,
+    Word* visited,
+    Word* next,
+    const Word* frontier
+) {
+  std::size_t rest = _visited.size() % detail::WORD_BITS;
+  std::size_t last = _visited.size() / detail::WORD_BITS;
+
+  Step result;
+  for (std::size_t w = begin; w < end; ++w) {
+    Word unvisited = ~visited[w];
+    if (w == last) {
+      unvisited &= detail::range_mask(0, rest);
+    }
+    Word found = 0;
+    while (unvisited != 0) {
+      auto bit = static_cast<std::size_t>(std::countl_zero(unvisited));
+      unvisited ^= detail::bit_mask(bit);
+      auto vertex = static_cast<std::uint32_t>(w * detail::WORD_BITS + bit);
+      for (std::uint32_t neighbour : _in.neighbours(vertex)) {
+        if ((frontier[neighbour / detail::WORD_BITS] & detail::bit_mask(neighbour % detail::WORD_BITS)) != 0) {
+          _parents[vertex] = neighbour;
+          found |= detail::bit_mask(bit);
+          ++result.vertices;
+          result.edges += _out.degree(vertex);
+          break;
+        }
+      }
+    }
+    next[w] = found;
+    visited[w] |= found;
+  }
+  return result;
+}
+
+void BreadthFirstSearch::queue_to_bitset() {
+  _frontier.subview().assign_indices(std::span<const std::uint32_t>(_queue));
+}
+
+void BreadthFirstSearch::bitset_to_queue() {
+  _queue.clear();
+  _frontier.append_indices(_queue);
+}
+
+} // namespace ct
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "bitset.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ct {
+
+// Graph in compressed sparse row form: the neighbours of vertex `v` are `targets[offsets[v]]` up to
+// `targets[offsets[v + 1]]`, so `offsets` has one element more than there are vertices. The spans are not owned.
+struct CsrGraph {
+  std::span<const std::uint64_t> offsets;
+  std::span<const std::uint32_t> targets;
+
+  std::size_t vertices() const {
+    return offsets.empty() ? 0 : offsets.size() - 1;
+  }
+
+  std::size_t degree(std::uint32_t vertex) const {
+    return offsets[vertex + 1] - offsets[vertex];
+  }
+
+  std::span<const std::uint32_t> neighbours(std::uint32_t vertex) const {
+    return targets.subspan(offsets[vertex], degree(vertex));
+  }
+};
+
+// Direction-optimizing breadth-first search. Small frontiers are expanded top-down from a queue of vertices, claiming
+// their unvisited neighbours with an atomic OR on the visited bitset. Large frontiers are kept as a bitset and
+// expanded bottom-up: every unvisited vertex, found by scanning the visited words, looks for a parent among its
+// incoming neighbours and stops at the first one in the frontier. The search switches to bottom-up when the edges out
+// of the frontier exceed `1 / ALPHA` of the edges left unexplored, and back when the frontier shrinks below
+// `1 / BETA` of the vertices.
+//
+// Steps are split between `threads` threads, each bottom-up one owning whole words of the bitsets. All buffers are
+// allocated once and reused by every search.
+class BreadthFirstSearch {
+public:
+  static constexpr std::uint32_t NO_PARENT = -1;
+  static constexpr std::size_t ALPHA = 14;
+  static constexpr std::size_t BETA = 24;
+
+  // The graph must be symmetric, so that it also gives the incoming edges of every vertex
+  explicit BreadthFirstSearch(const CsrGraph& graph, std::size_t threads = 1);
+  // `in` holds the incoming edges: the transpose of `out`, with the same vertices
+  BreadthFirstSearch(const CsrGraph& out, const CsrGraph& in, std::size_t threads = 1);
+
+  // Visits every vertex reachable from `source` and records its parent in the search tree
+  void run(std::uint32_t source);
+
+  // Reachable vertices of the last search
+  const BitSet& visited() const;
+
+  // Parent of every vertex in the last search: itself for the source and `NO_PARENT` for unreachable vertices
+  std::span<const std::uint32_t> parents() const;
+
+  // Number of expanded frontiers of the last search, in each direction
+  std::size_t top_down_steps() const;
+  std::size_t bottom_up_steps() const;
+
+private:
+  // New vertices and the edges out of them, found by one step
+  struct Step {
+    std::size_t vertices = 0;
+    std::size_t edges = 0;
+  };
+
+  Step top_down();
+  Step bottom_up();
+
+  // The words of the bitsets are taken by the calling thread and passed to the workers, which never touch the
+  // bitsets themselves
+  template <bool ATOMIC>
+  Step top_down_range(std::size_t begin, std::size_t end, detail::Word* visited, std::vector<std::uint32_t>& next);
+  Step bottom_up_range(
+      std::size_t begin, std::size_t end, detail::Word* visited, detail::Word* next, const detail::Word* frontier
+  );
+
+  void queue_to_bitset();
+  void bitset_to_queue();
+
+private:
+  CsrGraph _out;
+  CsrGraph _in;
+  std::size_t _threads;
+
+  BitSet _visited;
+  BitSet _frontier;
+  BitSet _next;
+  std::vector<std::uint32_t> _queue;
+  std::vector<std::vector<std::uint32_t>> _next_queues;
+  std::vector<std::uint32_t> _parents;
+
+  std::size_t _top_down_steps = 0;
+  std::size_t _bottom_up_steps = 0;
+};
+
+} // namespace ct
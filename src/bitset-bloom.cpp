@@ -0,0 +1,114 @@
+#include "bitset-bloom.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+namespace ct {
+
+namespace {
+
+using detail::Word;
+using detail::WORD_BITS;
+
+constexpr std::size_t PREFETCH_DISTANCE = 16;
+
+// Odd multipliers from the split block Bloom filter of Apache Parquet
+constexpr std::array<std::uint32_t, BlockedBloomFilter::BLOCK_WORDS> SALT = {
+    0x47b6'137b,
+    0x4497'4d91,
+    0x8824'ad5b,
+    0xa2b7'289d,
+    0x7054'95c7,
+    0x2df1'424b,
+    0x9efc'4947,
+    0x5c6b'fb31,
+};
+
+// The top six bits of the 32-bit product with the salt select the bit of word `i` of the block
+Word probe(std::uint64_t hash, std::size_t i) {
+  auto product = static_cast<std::uint32_t>(static_cast<std::uint32_t>(hash) * SALT[i]);
+  return detail::bit_mask(product >> 26);
+}
+
+const BitSet::ConstView& checked_filter_bits(const BitSet::ConstView& bits) {
+  if (bits.empty() || bits.size() % BlockedBloomFilter::BLOCK_BITS != 0) {
+    throw std::invalid_argument("filter bits are not a positive number of whole blocks");
+  }
+  return bits;
+}
+
+} // namespace
+
+BlockedBloomFilter::BlockedBloomFilter(std::size_t bits)
+    : _bits(std::max<std::size_t>((bits + BLOCK_BITS - 1) / BLOCK_BITS, 1) * BLOCK_BITS, false)
+    , _blocks(_bits.size() / BLOCK_BITS) {}
+
+BlockedBloomFilter::BlockedBloomFilter(const BitSet::ConstView& bits)
+    : _bits(checked_filter_bits(bits))
+    , _blocks(_bits.size() / BLOCK_BITS) {}
+
+void BlockedBloomFilter::insert(std::uint64_t hash) {
+  Word* words = block(hash);
+  for (std::size_t i = 0; i < BLOCK_WORDS; ++i) {
+    words[i] |= probe(hash, i);
+  }
+}
+
+bool BlockedBloomFilter::contains(std::uint64_t hash) const {
+  const Word* words = block(hash);
+  Word missing = 0;
+  for (std::size_t i = 0; i < BLOCK_WORDS; ++i) {
+    missing |= probe(hash, i) & ~words[i];
+  }
+  return missing == 0;
+}
+
+void BlockedBloomFilter::insert(std::span<const std::uint64_t> hashes) {
+  for (std::size_t i = 0; i < hashes.size(); ++i) {
+    if (i + PREFETCH_DISTANCE < hashes.size()) {
+      detail::prefetch(block(hashes[i + PREFETCH_DISTANCE]));
+    }
+    insert(hashes[i]);
+  }
+}
+
+void BlockedBloomFilter::contains(std::span<const std::uint64_t> hashes, std::span<bool> out) const {
+  for (std::size_t i = 0; i < hashes.size(); ++i) {
+    if (i + PREFETCH_DISTANCE < hashes.size()) {
+      detail::prefetch(block(hashes[i + PREFETCH_DISTANCE]));
+    }
+    out[i] = contains(hashes[i]);
+  }
+}
+
+BlockedBloomFilter& BlockedBloomFilter::operator|=(const BlockedBloomFilter& other) & {
+  _bits |= other._bits;
+  return *this;
+}
+
+BlockedBloomFilter& BlockedBloomFilter::operator&=(const BlockedBloomFilter& other) & {
+  _bits &= other._bits;
+  return *this;
+}
+
+void BlockedBloomFilter::clear() {
+  _bits.reset();
+}
+
+const BitSet& BlockedBloomFilter::bits() const {
+  return _bits;
+}
+
+// Maps the high half of the hash to a block by multiplication instead of a division
+const Word* BlockedBloomFilter::block(std::uint64_t hash) const {
+  std::uint64_t index = ((hash >> 32) * _blocks) >> 32;
+  return _bits.subview().data() + index * BLOCK_WORDS;
+}
+
+Word* BlockedBloomFilter::block(std::uint64_t hash) {
+  std::uint64_t index = ((hash >> 32) * _blocks) >> 32;
+  return BitSet::View(_bits).data() + index * BLOCK_WORDS;
+}
+
+} // namespace ct
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "bitset.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace ct {
+
+// Bloom filter whose probes for a key all fall into one block of eight words (64 bytes), so that a lookup touches a
+// single cache line instead of one line per probe. The block is chosen by the high half of the key's hash; the low
+// half is multiplied by eight odd constants to select one bit in every word of the block. The eight lanes are
+// independent, so the compiler can evaluate them with vector instructions.
+//
+// Keys are passed as 64-bit hashes, which must be well mixed (e.g. `std::hash` of an integer is not). Filters can be
+// combined with `|=` and `&=` when they have the same size, and are serialized by saving `bits()`.
+class BlockedBloomFilter {
+public:
+  static constexpr std::size_t BLOCK_WORDS = 8;
+  static constexpr std::size_t BLOCK_BITS = BLOCK_WORDS * detail::WORD_BITS;
+
+  // At least `bits` bits, rounded up to whole blocks. There can be at most 2^32 blocks.
+  explicit BlockedBloomFilter(std::size_t bits);
+  // Restores a filter from its bits; their number must be a positive multiple of `BLOCK_BITS`, or
+  // `std::invalid_argument` is thrown
+  explicit BlockedBloomFilter(const BitSet::ConstView& bits);
+
+  void insert(std::uint64_t hash);
+  bool contains(std::uint64_t hash) const;
+
+  // Batched versions, prefetching the blocks of upcoming keys so that their cache misses overlap
+  void insert(std::span<const std::uint64_t> hashes);
+  void contains(std::span<const std::uint64_t> hashes, std::span<bool> out) const;
+
+  BlockedBloomFilter& operator|=(const BlockedBloomFilter& other) &;
+  BlockedBloomFilter& operator&=(const BlockedBloomFilter& other) &;
+
+  void clear();
+
+  const BitSet& bits() const;
+
+private:
+  const detail::Word* block(std::uint64_t hash) const;
+  detail::Word* block(std::uint64_t hash);
+
+private:
+  BitSet _bits;
+  std::size_t _blocks;
+};
+
+} // namespace ct
@@ -0,0 +1,226 @@
+#include "bitset-complement.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace ct {
+
+namespace {
+
+using detail::Word;
+
+// Whether every bit of `lhs` differs from the matching bit of `rhs`, for ranges of the same size
+bool equal_complement(const BitSet::ConstView& lhs, const BitSet::ConstView& rhs) {
+  for (std::size_t position = 0; position < lhs.size(); position += detail::WORD_BITS) {
+    std::size_t count = std::min(detail::WORD_BITS, lhs.size() - position);
+    Word left = detail::load_bits(lhs.data(), lhs.offset() + position, count);
+    Word right = detail::load_bits(rhs.data(), rhs.offset() + position, count);
+    if ((left ^ right) != detail::range_mask(0, count)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+ComplementBitSet::ComplementBitSet() = default;
+
+ComplementBitSet::ComplementBitSet(std::size_t size, bool value)
+    : _bits(size, value) {}
+
+ComplementBitSet::ComplementBitSet(const ConstView& bits)
+    : _bits(bits) {}
+
+ComplementBitSet::ComplementBitSet(const Operand& bits)
+    : _bits(bits._bits)
+    , _complemented(bits._complemented) {}
+
+void ComplementBitSet::swap(ComplementBitSet& other) {
+  _bits.swap(other._bits);
+  std::swap(_complemented, other._complemented);
+}
+
+std::size_t ComplementBitSet::size() const {
+  return _bits.size();
+}
+
+bool ComplementBitSet::empty() const {
+  return _bits.empty();
+}
+
+bool ComplementBitSet::complemented() const {
+  return _complemented;
+}
+
+bool ComplementBitSet::operator[](std::size_t index) const {
+  return _bits[index] != _complemented;
+}
+
+void ComplementBitSet::set(std::size_t index, bool value) {
+  _bits[index] = value != _complemented;
+}
+
+void ComplementBitSet::flip(std::size_t index) {
+  _bits[index].flip();
+}
+
+ComplementBitSet::ConstIterator ComplementBitSet::begin() const {
+  return {_bits.begin(), _complemented};
+}
+
+ComplementBitSet::ConstIterator ComplementBitSet::end() const {
+  return {_bits.end(), _complemented};
+}
+
+ComplementBitSet::View ComplementBitSet::mutable_view() {
+  materialize();
+  return _bits;
+}
+
+ComplementBitSet::ConstView ComplementBitSet::view() {
+  materialize();
+  return std::as_const(_bits);
+}
+
+ComplementBitSet& ComplementBitSet::operator&=(const ConstView& other) & {
+  return combine_and(other, false);
+}
+
+ComplementBitSet& ComplementBitSet::operator|=(const ConstView& other) & {
+  return combine_or(other, false);
+}
+
+ComplementBitSet& ComplementBitSet::operator^=(const ConstView& other) & {
+  _bits ^= other;
+  return *this;
+}
+
+ComplementBitSet& ComplementBitSet::operator&=(const ComplementBitSet& other) & {
+  return *this &= Operand(other._bits, other._complemented);
+}
+
+ComplementBitSet& ComplementBitSet::operator|=(const ComplementBitSet& other) & {
+  return *this |= Operand(other._bits, other._complemented);
+}
+
+ComplementBitSet& ComplementBitSet::operator^=(const ComplementBitSet& other) & {
+  return *this ^= Operand(other._bits, other._complemented);
+}
+
+ComplementBitSet& ComplementBitSet::operator&=(const Operand& other) & {
+  return combine_and(other._bits, other._complemented);
+}
+
+ComplementBitSet& ComplementBitSet::operator|=(const Operand& other) & {
+  return combine_or(other._bits, other._complemented);
+}
+
+ComplementBitSet& ComplementBitSet::operator^=(const Operand& other) & {
+  bool complemented = _complemented != other._complemented;
+  _bits ^= other._bits;
+  _complemented = complemented;
+  return *this;
+}
+
+ComplementBitSet& ComplementBitSet::flip() & {
+  _complemented = !_complemented;
+  return *this;
+}
+
+ComplementBitSet& ComplementBitSet::set() & {
+  _bits.set();
+  _complemented = false;
+  return *this;
+}
+
+ComplementBitSet& ComplementBitSet::reset() & {
+  _bits.reset();
+  _complemented = false;
+  return *this;
+}
+
+bool ComplementBitSet::all() const {
+  return _complemented ? !_bits.any() : _bits.all();
+}
+
+bool ComplementBitSet::any() const {
+  return _complemented ? !_bits.all() : _bits.any();
+}
+
+std::size_t ComplementBitSet::count() const {
+  std::size_t ones = _bits.count();
+  return _complemented ? size() - ones : ones;
+}
+
+bool operator==(const ComplementBitSet& lhs, const ComplementBitSet& rhs) {
+  if (lhs._complemented == rhs._complemented) {
+    return lhs._bits == rhs._bits;
+  }
+  return lhs.size() == rhs.size() && equal_complement(lhs._bits, rhs._bits);
+}
+
+bool operator==(const ComplementBitSet& lhs, const BitSet::ConstView& rhs) {
+  if (!lhs._complemented) {
+    return BitSet::ConstView(lhs._bits) == rhs;
+  }
+  return lhs.size() == rhs.size() && equal_complement(lhs._bits, rhs);
+}
+
+void ComplementBitSet::materialize() {
+  if (_complemented) {
+    _bits.flip();
+    _complemented = false;
+  }
+}
+
+// With the stored words `s` and the flag `f`, the bits are `s ^ f`. The other operand `t` is first complemented when
+// exactly one of the flags is set, giving `u`. Then `(s ^ f) & (t ^ g)` is `s & u` when `f` is clear, and by De Morgan
+// `~(s | u)` when it is set, which keeps the flag.
+ComplementBitSet& ComplementBitSet::combine_and(const ConstView& other, bool other_complemented) {
+  Word* data = View(_bits).data();
+  if (_complemented == other_complemented && _complemented) {
+    _bits |= other;
+  } else if (_complemented == other_complemented) {
+    _bits &= other;
+  } else if (_complemented) {
+    detail::transform(data, 0, other.data(), other.offset(), size(), [](Word s, Word t) { return s | ~t; });
+  } else {
+    detail::transform(data, 0, other.data(), other.offset(), size(), [](Word s, Word t) { return s & ~t; });
+  }
+  return *this;
+}
+
+// The same with `|` and `&` exchanged
+ComplementBitSet& ComplementBitSet::combine_or(const ConstView& other, bool other_complemented) {
+  Word* data = View(_bits).data();
+  if (_complemented == other_complemented && _complemented) {
+    _bits &= other;
+  } else if (_complemented == other_complemented) {
+    _bits |= other;
+  } else if (_complemented) {
+    detail::transform(data, 0, other.data(), other.offset(), size(), [](Word s, Word t) { return s & ~t; });
+  } else {
+    detail::transform(data, 0, other.data(), other.offset(), size(), [](Word s, Word t) { return s | ~t; });
+  }
+  return *this;
+}
+
+ComplementBitSet::Operand operator~(const ComplementBitSet& bits) {
+  return {bits._bits, !bits._complemented};
+}
+
+void swap(ComplementBitSet& lhs, ComplementBitSet& rhs) {
+  lhs.swap(rhs);
+}
+
+std::string to_string(const ComplementBitSet& bits) {
+  std::string result;
+  result.reserve(bits.size());
+  for (bool bit : bits) {
+    result.push_back(bit ? '1' : '0');
+  }
+  return result;
+}
+
+} // namespace ct
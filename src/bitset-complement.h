@@ -0,0 +1,156 @@
+#pragma once
+
+#include "bitset.h"
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+
+namespace ct {
+
+// Bitset whose `flip` is O(1): the words are stored as is or complemented, as told by a flag, and reads apply the
+// flag on the fly. `count`, `all` and `any` are answered from the stored words, and bitwise operations fold both
+// flags into a single and, or, and-not or or-not pass, so `a &= ~b` costs no more than `a &= b`.
+//
+// The stored words are exposed only through `view` and `mutable_view`, which complement them in place first, so the
+// flag costs nothing to code that works on the words directly. A plain `BitSet` pays nothing for the flag.
+class ComplementBitSet {
+public:
+  using View = BitSet::View;
+  using ConstView = BitSet::ConstView;
+
+  // Read-only iterator over the logical bits
+  class ConstIterator {
+  public:
+    using value_type = bool;
+    using reference = bool;
+    using pointer = void;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    ConstIterator() = default;
+
+    bool operator*() const {
+      return *_it != _complemented;
+    }
+
+    ConstIterator& operator++() {
+      ++_it;
+      return *this;
+    }
+
+    ConstIterator operator++(int) {
+      ConstIterator copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    friend bool operator==(const ConstIterator& lhs, const ConstIterator& rhs) {
+      return lhs._it == rhs._it;
+    }
+
+  private:
+    ConstIterator(BitSet::ConstIterator it, bool complemented)
+        : _it(it)
+        , _complemented(complemented) {}
+
+  private:
+    BitSet::ConstIterator _it;
+    bool _complemented = false;
+
+    friend class ComplementBitSet;
+  };
+
+  // Non-owning operand for the bits of a set, possibly complemented, as returned by `~`. Nothing is copied, so
+  // `a &= ~b` costs a single pass; the set must outlive the operand.
+  class Operand {
+  public:
+    std::size_t size() const {
+      return _bits.size();
+    }
+
+    ConstIterator begin() const {
+      return {_bits.begin(), _complemented};
+    }
+
+    ConstIterator end() const {
+      return {_bits.end(), _complemented};
+    }
+
+  private:
+    Operand(const ConstView& bits, bool complemented)
+        : _bits(bits)
+        , _complemented(complemented) {}
+
+  private:
+    ConstView _bits;
+    bool _complemented;
+
+    friend class ComplementBitSet;
+    friend Operand operator~(const ComplementBitSet& bits);
+  };
+
+  ComplementBitSet();
+  ComplementBitSet(std::size_t size, bool value);
+  explicit ComplementBitSet(const ConstView& bits);
+  // Copies the bits of the operand, keeping its flag
+  ComplementBitSet(const Operand& bits);
+
+  void swap(ComplementBitSet& other);
+
+  std::size_t size() const;
+  bool empty() const;
+
+  // Whether the stored words hold the complement of the bits
+  bool complemented() const;
+
+  bool operator[](std::size_t index) const;
+  void set(std::size_t index, bool value = true);
+  void flip(std::size_t index);
+
+  ConstIterator begin() const;
+  ConstIterator end() const;
+
+  // Complement the stored words first if needed, so that they hold the bits themselves
+  View mutable_view();
+  ConstView view();
+
+  ComplementBitSet& operator&=(const ConstView& other) &;
+  ComplementBitSet& operator|=(const ConstView& other) &;
+  ComplementBitSet& operator^=(const ConstView& other) &;
+  ComplementBitSet& operator&=(const ComplementBitSet& other) &;
+  ComplementBitSet& operator|=(const ComplementBitSet& other) &;
+  ComplementBitSet& operator^=(const ComplementBitSet& other) &;
+  ComplementBitSet& operator&=(const Operand& other) &;
+  ComplementBitSet& operator|=(const Operand& other) &;
+  ComplementBitSet& operator^=(const Operand& other) &;
+  ComplementBitSet& flip() &;
+  ComplementBitSet& set() &;
+  ComplementBitSet& reset() &;
+
+  bool all() const;
+  bool any() const;
+  std::size_t count() const;
+
+  friend bool operator==(const ComplementBitSet& lhs, const ComplementBitSet& rhs);
+  friend bool operator==(const ComplementBitSet& lhs, const ConstView& rhs);
+  friend Operand operator~(const ComplementBitSet& bits);
+
+private:
+  void materialize();
+
+  ComplementBitSet& combine_and(const ConstView& other, bool other_complemented);
+  ComplementBitSet& combine_or(const ConstView& other, bool other_complemented);
+
+private:
+  BitSet _bits;
+  bool _complemented = false;
+};
+
+ComplementBitSet::Operand operator~(const ComplementBitSet& bits);
+
+void swap(ComplementBitSet& lhs, ComplementBitSet& rhs);
+
+std::string to_string(const ComplementBitSet& bits);
+
+} // namespace ct
@@ -0,0 +1,166 @@
+#include "bitset-extract.h"
+
+#include <bit>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <immintrin.h>
+#define CT_BITSET_BMI2_DISPATCH 1
+#endif
+
+namespace ct {
+
+namespace detail {
+
+// Both loops run once per set bit of the mask, without data-dependent branches
+Word extract_word(Word value, Word mask) {
+  Word result = 0;
+  for (Word bit = 1; mask != 0; bit <<= 1) {
+    Word lowest = mask & ~(mask - 1);
+    result |= bit * Word((value & lowest) != 0);
+    mask ^= lowest;
+  }
+  return result;
+}
+
+Word deposit_word(Word value, Word mask) {
+  Word result = 0;
+  for (Word bit = 1; mask != 0; bit <<= 1) {
+    Word lowest = mask & ~(mask - 1);
+    result |= lowest * Word((value & bit) != 0);
+    mask ^= lowest;
+  }
+  return result;
+}
+
+} // namespace detail
+
+namespace {
+
+using detail::Word;
+using detail::WORD_BITS;
+
+struct PortableGather {
+  static Word extract(Word value, Word mask) {
+    return detail::extract_word(value, mask);
+  }
+
+  static Word deposit(Word value, Word mask) {
+    return detail::deposit_word(value, mask);
+  }
+};
+
+#ifdef CT_BITSET_BMI2_DISPATCH
+
+struct Bmi2Gather {
+  [[gnu::target("bmi2")]] static Word extract(Word value, Word mask) {
+    return _pext_u64(value, mask);
+  }
+
+  [[gnu::target("bmi2")]] static Word deposit(Word value, Word mask) {
+    return _pdep_u64(value, mask);
+  }
+};
+
+// AMD processors before Zen 3 implement `pext` and `pdep` in microcode, with a latency of hundreds of cycles
+bool fast_bmi2() {
+  static const bool result = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("bmi2") && !__builtin_cpu_is("amdfam15h") && !__builtin_cpu_is("amdfam17h");
+  }();
+  return result;
+}
+
+#endif
+
+// Logical chunks of the mask are gathered into the least significant bits and appended to `out` in the most
+// significant ones, carrying the bits that do not fit into the current output word over to the next one
+template <typename Gather>
+void extract_bits(const BitSet::ConstView& src, const BitSet::ConstView& mask, Word* out) {
+  Word pending = 0;
+  std::size_t filled = 0;
+  std::size_t position = src.offset();
+  detail::for_each_chunk(mask.data(), mask.offset(), mask.size(), [&](Word selector, std::size_t count) {
+    auto ones = static_cast<std::size_t>(std::popcount(selector));
+    if (ones != 0) {
+      Word value = detail::load_bits(src.data(), position, count);
+      Word bits = Gather::extract(value, selector) << (WORD_BITS - ones);
+      pending |= bits >> filled;
+      if (filled + ones < WORD_BITS) {
+        filled += ones;
+      } else {
+        *out++ = pending;
+        pending = (filled == 0) ? 0 : bits << (WORD_BITS - filled);
+        filled = filled + ones - WORD_BITS;
+      }
+    }
+    position += count;
+  });
+  if (filled != 0) {
+    *out = pending;
+  }
+}
+
+template <typename Gather>
+void deposit_bits(const BitSet::ConstView& src, const BitSet::ConstView& mask, const BitSet::View& dst) {
+  std::size_t consumed = src.offset();
+  std::size_t position = dst.offset();
+  detail::for_each_chunk(mask.data(), mask.offset(), mask.size(), [&](Word selector, std::size_t count) {
+    auto ones = static_cast<std::size_t>(std::popcount(selector));
+    if (ones != 0) {
+      Word bits = detail::load_bits(src.data(), consumed, ones) >> (WORD_BITS - ones);
+      Word kept = detail::load_bits(dst.data(), position, count) & ~selector;
+      detail::store_bits(dst.data(), position, count, kept | Gather::deposit(bits, selector));
+      consumed += ones;
+    }
+    position += count;
+  });
+}
+
+#ifdef CT_BITSET_BMI2_DISPATCH
+
+// The kernels are inlined into functions compiled for BMI2, so that the instructions are not called out of line.
+// Every CPU with BMI2 also has `popcnt`, which the default build does not assume.
+[[gnu::target("bmi2,popcnt"), gnu::flatten]] void extract_bmi2(
+    const BitSet::ConstView& src,
+    const BitSet::ConstView& mask,
+    Word* out
+) {
+  extract_bits<Bmi2Gather>(src, mask, out);
+}
+
+[[gnu::target("bmi2,popcnt"), gnu::flatten]] void deposit_bmi2(
+    const BitSet::ConstView& src,
+    const BitSet::ConstView& mask,
+    const BitSet::View& dst
+) {
+  deposit_bits<Bmi2Gather>(src, mask, dst);
+}
+
+#endif
+
+} // namespace
+
+BitSet extract(const BitSet::ConstView& src, const BitSet::ConstView& mask) {
+  BitSet result(mask.count(), false);
+  Word* out = BitSet::View(result).data();
+#ifdef CT_BITSET_BMI2_DISPATCH
+  if (fast_bmi2()) {
+    extract_bmi2(src, mask, out);
+    return result;
+  }
+#endif
+  extract_bits<PortableGather>(src, mask, out);
+  return result;
+}
+
+void deposit(const BitSet::ConstView& src, const BitSet::ConstView& mask, const BitSet::View& dst) {
+#ifdef CT_BITSET_BMI2_DISPATCH
+  if (fast_bmi2()) {
+    deposit_bmi2(src, mask, dst);
+    return;
+  }
+#endif
+  deposit_bits<PortableGather>(src, mask, dst);
+}
+
+} // namespace ct
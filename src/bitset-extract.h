@@ -0,0 +1,30 @@
+#pragma once
+
+#include "bitset.h"
+
+#include <cstddef>
+
+namespace ct {
+
+namespace detail {
+
+// Portable equivalents of the BMI2 `pext` and `pdep` instructions on a single word, in their native order: the lowest
+// selected bit of `value` goes to (or comes from) the least significant bit of the result
+Word extract_word(Word value, Word mask);
+Word deposit_word(Word value, Word mask);
+
+} // namespace detail
+
+// Gathering and scattering of bits selected by a mask. Both process one word of the mask at a time with `pext` and
+// `pdep` when the CPU has fast BMI2 instructions, and with a loop over the set bits of the mask otherwise; the choice
+// is made once at run time. The views may start at any offset.
+
+// The bits of `src` at the positions set in `mask`, in order. Expects `src.size() == mask.size()`.
+BitSet extract(const BitSet::ConstView& src, const BitSet::ConstView& mask);
+
+// Writes the leading `mask.count()` bits of `src`, in order, to the positions set in `mask`; the other bits of `dst`
+// keep their values. Expects `dst.size() == mask.size()`, `src.size() >= mask.count()` and no overlap between `src`
+// and `dst`.
+void deposit(const BitSet::ConstView& src, const BitSet::ConstView& mask, const BitSet::View& dst);
+
+} // namespace ct
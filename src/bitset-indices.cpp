@@ -0,0 +1,68 @@
+#include "bitset-indices.h"
+
+#include <bit>
+
+namespace ct::detail {
+
+namespace {
+
+template <typename T>
+void assign(Word* data, std::size_t offset, std::size_t size, std::span<const T> indices) {
+  fill(data, offset, size, false);
+  std::size_t i = 0;
+  while (i < indices.size()) {
+    std::size_t word = (offset + indices[i]) / WORD_BITS;
+    Word bits = 0;
+    for (; i < indices.size() && (offset + indices[i]) / WORD_BITS == word; ++i) {
+      bits |= bit_mask((offset + indices[i]) % WORD_BITS);
+    }
+    data[word] |= bits;
+  }
+}
+
+// Each storage word is decoded without a data-dependent exit: the number of set bits is known upfront from
+// `popcount`, and every step takes the highest remaining bit with `countl_zero`. The scan stops at the word that fills
+// `out`. `base` is the position of the first bit of the current word relative to the range; it wraps around below
+// zero for the first word of a misaligned range, whose bits before the range are masked out.
+template <typename T>
+std::size_t extract(const Word* data, std::size_t offset, std::size_t size, std::span<T> out) {
+  if (out.empty()) {
+    return 0;
+  }
+  std::size_t written = 0;
+  std::size_t base = 0 - offset % WORD_BITS;
+  for_each_segment(data, offset, size, [&](Word word, Word mask) {
+    Word chunk = word & mask;
+    auto ones = std::min(static_cast<std::size_t>(std::popcount(chunk)), out.size() - written);
+    T* target = out.data() + written;
+    for (std::size_t i = 0; i < ones; ++i) {
+      auto position = static_cast<std::size_t>(std::countl_zero(chunk));
+      target[i] = static_cast<T>(base + position);
+      chunk ^= bit_mask(position);
+    }
+    written += ones;
+    base += WORD_BITS;
+    return written != out.size();
+  });
+  return written;
+}
+
+} // namespace
+
+void assign_indices(Word* data, std::size_t offset, std::size_t size, std::span<const std::uint32_t> indices) {
+  assign(data, offset, size, indices);
+}
+
+void assign_indices(Word* data, std::size_t offset, std::size_t size, std::span<const std::uint64_t> indices) {
+  assign(data, offset, size, indices);
+}
+
+std::size_t extract_indices(const Word* data, std::size_t offset, std::size_t size, std::span<std::uint32_t> out) {
+  return extract(data, offset, size, out);
+}
+
+std::size_t extract_indices(const Word* data, std::size_t offset, std::size_t size, std::span<std::uint64_t> out) {
+  return extract(data, offset, size, out);
+}
+
+} // namespace ct::detail
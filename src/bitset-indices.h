@@ -0,0 +1,20 @@
+#pragma once
+
+#include "bitset-words.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Conversions between bit ranges and lists of positions of set bits
+namespace ct::detail {
+
+// Clears the range and sets the listed positions. Sorted input is written one storage word at a time.
+void assign_indices(Word* data, std::size_t offset, std::size_t size, std::span<const std::uint32_t> indices);
+void assign_indices(Word* data, std::size_t offset, std::size_t size, std::span<const std::uint64_t> indices);
+
+// Writes ascending positions of set bits to `out`, stopping when it is full; returns the number of written positions
+std::size_t extract_indices(const Word* data, std::size_t offset, std::size_t size, std::span<std::uint32_t> out);
+std::size_t extract_indices(const Word* data, std::size_t offset, std::size_t size, std::span<std::uint64_t> out);
+
+} // namespace ct::detail
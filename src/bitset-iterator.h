@@ -1,7 +1,125 @@
 #pragma once
 
+#include "bitset-reference.h"
+#include "bitset-words.h"
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
 namespace ct {
 
-// TODO BitSet iterators
+// Random-access iterator over bits. The position is kept normalized as a word pointer plus a bit offset
+// inside that word, so that iterators obtained from different views over the same storage compare equal.
+template <typename W>
+class BitIterator {
+  using MutableWord = std::remove_const_t<W>;
+
+public:
+  using value_type = bool;
+  using reference = BitReference<W>;
+  using pointer = void;
+  using difference_type = std::ptrdiff_t;
+  using iterator_category = std::random_access_iterator_tag;
+
+  BitIterator() = default;
+
+  template <typename U>
+  BitIterator(const BitIterator<U>& other)
+    requires (std::is_const_v<W> && !std::is_const_v<U>)
+      : _word(other._word)
+      , _offset(other._offset) {}
+
+  reference operator*() const {
+    return reference(_word, detail::bit_mask(_offset));
+  }
+
+  reference operator[](difference_type n) const {
+    return *(*this + n);
+  }
+
+  BitIterator& operator++() {
+    if (++_offset == detail::WORD_BITS) {
+      _offset = 0;
+      ++_word;
+    }
+    return *this;
+  }
+
+  BitIterator operator++(int) {
+    BitIterator copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  BitIterator& operator--() {
+    if (_offset-- == 0) {
+      _offset = detail::WORD_BITS - 1;
+      --_word;
+    }
+    return *this;
+  }
+
+  BitIterator operator--(int) {
+    BitIterator copy = *this;
+    --*this;
+    return copy;
+  }
+
+  BitIterator& operator+=(difference_type n) {
+    difference_type position = static_cast<difference_type>(_offset) + n;
+    difference_type words = position / static_cast<difference_type>(detail::WORD_BITS);
+    difference_type bits = position % static_cast<difference_type>(detail::WORD_BITS);
+    if (bits < 0) {
+      bits += static_cast<difference_type>(detail::WORD_BITS);
+      --words;
+    }
+    _word += words;
+    _offset = static_cast<std::size_t>(bits);
+    return *this;
+  }
+
+  BitIterator& operator-=(difference_type n) {
+    return *this += -n;
+  }
+
+  friend BitIterator operator+(BitIterator it, difference_type n) {
+    return it += n;
+  }
+
+  friend BitIterator operator+(difference_type n, BitIterator it) {
+    return it += n;
+  }
+
+  friend BitIterator operator-(BitIterator it, difference_type n) {
+    return it -= n;
+  }
+
+  friend difference_type operator-(const BitIterator& lhs, const BitIterator& rhs) {
+    return (lhs._word - rhs._word) * static_cast<difference_type>(detail::WORD_BITS) +
+           (static_cast<difference_type>(lhs._offset) - static_cast<difference_type>(rhs._offset));
+  }
+
+  friend bool operator==(const BitIterator& lhs, const BitIterator& rhs) = default;
+  friend std::strong_ordering operator<=>(const BitIterator& lhs, const BitIterator& rhs) = default;
+
+private:
+  BitIterator(W* word, std::size_t offset)
+      : _word(word + offset / detail::WORD_BITS)
+      , _offset(offset % detail::WORD_BITS) {}
+
+private:
+  W* _word;
+  std::size_t _offset;
+
+  friend class BitSet;
+
+  template <typename>
+  friend class BitIterator;
+
+  template <typename>
+  friend class BitView;
+};
 
 } // namespace ct
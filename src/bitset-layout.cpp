@@ -0,0 +1,21 @@
+#include "bitset-layout.h"
+
+#include "bitset-reverse.h"
+
+#include <algorithm>
+
+namespace ct {
+
+void convert_layout(std::span<detail::Word> words, std::endian byte_order, BitOrder bit_order) {
+  bool swap_bytes = (byte_order != std::endian::native);
+  bool reverse_bits = (bit_order == BitOrder::LSB_FIRST);
+  if (swap_bytes && reverse_bits) {
+    std::ranges::transform(words, words.begin(), detail::reverse_bytes);
+  } else if (swap_bytes) {
+    std::ranges::transform(words, words.begin(), detail::byte_swap);
+  } else if (reverse_bits) {
+    std::ranges::transform(words, words.begin(), detail::reverse_word);
+  }
+}
+
+} // namespace ct
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "bitset-words.h"
+
+#include <bit>
+#include <cstddef>
+#include <span>
+
+namespace ct {
+
+// Order of bits inside a word of external storage. Bitsets number the bits of a word from the most significant one.
+enum class BitOrder {
+  MSB_FIRST,
+  LSB_FIRST,
+};
+
+// Whether words stored with the given byte order and bit order can be viewed as they are. For example, a stream of
+// bytes numbered from the most significant bit is native on big-endian machines, and a stream numbered from the least
+// significant bit (as in most bitmap formats) needs a conversion everywhere.
+constexpr bool is_native_layout(std::endian byte_order, BitOrder bit_order) {
+  return byte_order == std::endian::native && bit_order == BitOrder::MSB_FIRST;
+}
+
+// Converts words between the given layout and the native one in place, one word at a time. The conversion is its own
+// inverse: applying it again restores the original contents.
+void convert_layout(std::span<detail::Word> words, std::endian byte_order, BitOrder bit_order);
+
+} // namespace ct
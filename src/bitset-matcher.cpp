@@ -0,0 +1,151 @@
+#include "bitset-matcher.h"
+
+#include <algorithm>
+
+namespace ct {
+
+namespace {
+
+using detail::Word;
+using detail::WORD_BITS;
+
+constexpr std::size_t ALPHABET = 256;
+
+// The most significant bit holds the last pattern symbol
+constexpr Word LAST_SYMBOL = detail::bit_mask(0);
+
+// `state = (state << 1) | mask` over a multi-word big-endian number, shifting in a zero
+void shift_or(Word* state, const Word* mask, std::size_t words) {
+  for (std::size_t i = 0; i + 1 < words; ++i) {
+    state[i] = ((state[i] << 1) | (state[i + 1] >> (WORD_BITS - 1))) | mask[i];
+  }
+  state[words - 1] = (state[words - 1] << 1) | mask[words - 1];
+}
+
+// `state = ((state << 1) | mask) & (previous << 1)`; `previous` is read before it is updated itself
+void shift_or_and(Word* state, const Word* mask, const Word* previous, std::size_t words) {
+  for (std::size_t i = 0; i + 1 < words; ++i) {
+    Word shifted = (state[i] << 1) | (state[i + 1] >> (WORD_BITS - 1));
+    Word substituted = (previous[i] << 1) | (previous[i + 1] >> (WORD_BITS - 1));
+    state[i] = (shifted | mask[i]) & substituted;
+  }
+  state[words - 1] = ((state[words - 1] << 1) | mask[words - 1]) & (previous[words - 1] << 1);
+}
+
+} // namespace
+
+ShiftOrMatcher::ShiftOrMatcher(std::string_view pattern, std::size_t max_mismatches)
+    : _size(pattern.size())
+    , _masks(ALPHABET, pattern.size(), true)
+    , _states(max_mismatches + 1, pattern.size(), true)
+    , _position(0) {
+  for (std::size_t i = 0; i < _size; ++i) {
+    _masks[static_cast<unsigned char>(pattern[i])][_size - 1 - i] = false;
+  }
+}
+
+void ShiftOrMatcher::feed(std::string_view text, std::vector<Match>& matches) {
+  std::size_t words = detail::word_count(_size);
+  std::size_t levels = _states.rows();
+  if (words == 0) {
+    for (std::size_t i = 0; i < text.size(); ++i) {
+      matches.push_back({++_position, 0});
+    }
+    return;
+  }
+  Word* states = _states[0].data();
+  for (char symbol : text) {
+    const Word* mask = _masks[static_cast<unsigned char>(symbol)].data();
+    for (std::size_t level = levels - 1; level != 0; --level) {
+      shift_or_and(states + level * words, mask, states + (level - 1) * words, words);
+    }
+    shift_or(states, mask, words);
+    ++_position;
+    if ((states[(levels - 1) * words] & LAST_SYMBOL) == 0) {
+      std::size_t level = 0;
+      while ((states[level * words] & LAST_SYMBOL) != 0) {
+        ++level;
+      }
+      matches.push_back({_position, level});
+    }
+  }
+}
+
+void ShiftOrMatcher::reset() {
+  for (std::size_t level = 0; level < _states.rows(); ++level) {
+    _states[level].set();
+  }
+  _position = 0;
+}
+
+std::size_t ShiftOrMatcher::position() const {
+  return _position;
+}
+
+MyersMatcher::MyersMatcher(std::string_view pattern, std::size_t max_distance)
+    : _size(pattern.size())
+    , _max_distance(max_distance)
+    , _peq(ALPHABET, pattern.size(), false)
+    , _positive(pattern.size(), true)
+    , _negative(pattern.size(), false)
+    , _score(pattern.size())
+    , _position(0) {
+  for (std::size_t i = 0; i < _size; ++i) {
+    _peq[static_cast<unsigned char>(pattern[i])][_size - 1 - i] = true;
+  }
+}
+
+// One column of the edit distance matrix per symbol. Words are visited from the least significant one, so the carry
+// of the addition and the bits shifted into the horizontal deltas both come from the previous iteration.
+void MyersMatcher::feed(std::string_view text, std::vector<Match>& matches) {
+  std::size_t words = detail::word_count(_size);
+  Word tail = (_size % WORD_BITS == 0) ? detail::ALL_ONES : detail::range_mask(0, _size % WORD_BITS);
+  Word* positive = BitSet::View(_positive).data();
+  Word* negative = BitSet::View(_negative).data();
+  for (char symbol : text) {
+    const Word* peq = _peq[static_cast<unsigned char>(symbol)].data();
+    Word carry = 0;
+    Word positive_in = 0;
+    Word negative_in = 0;
+    for (std::size_t i = words; i-- != 0;) {
+      Word mask = (i == words - 1) ? tail : detail::ALL_ONES;
+      Word vp = positive[i];
+      Word vn = negative[i];
+      Word x = peq[i] | vn;
+      Word sum = vp + (x & vp);
+      Word overflow = (sum < vp);
+      sum += carry;
+      carry = overflow | (sum < carry);
+      Word d0 = (sum ^ vp) | x;
+      Word hn = vp & d0;
+      Word hp = (vn | ~(vp | d0)) & mask;
+      if (i == 0) {
+        _score += (hp & LAST_SYMBOL) != 0;
+        _score -= (hn & LAST_SYMBOL) != 0;
+      }
+      Word shifted_hp = (hp << 1) | positive_in;
+      Word shifted_hn = (hn << 1) | negative_in;
+      positive_in = hp >> (WORD_BITS - 1);
+      negative_in = hn >> (WORD_BITS - 1);
+      negative[i] = shifted_hp & d0;
+      positive[i] = (shifted_hn | ~(shifted_hp | d0)) & mask;
+    }
+    ++_position;
+    if (_score <= _max_distance) {
+      matches.push_back({_position, _score});
+    }
+  }
+}
+
+void MyersMatcher::reset() {
+  _positive.set();
+  _negative.reset();
+  _score = _size;
+  _position = 0;
+}
+
+std::size_t MyersMatcher::position() const {
+  return _position;
+}
+
+} // namespace ct
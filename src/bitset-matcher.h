@@ -0,0 +1,74 @@
+#pragma once
+
+#include "bitset-matrix.h"
+#include "bitset.h"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace ct {
+
+struct Match {
+  // Position one past the last matched text symbol, counted from the beginning of the stream
+  std::size_t end;
+  // Number of mismatches or edits of the best occurrence ending there
+  std::size_t errors;
+
+  friend bool operator==(const Match& left, const Match& right) = default;
+};
+
+// Bit-parallel matchers for patterns of any length. The text is consumed in chunks by `feed`, which appends the
+// occurrences ending inside the chunk, so a stream can be searched without keeping it in memory. Every text symbol
+// costs a single fused pass over the state words; nothing is allocated after construction.
+//
+// State vectors keep the pattern reversed: pattern symbol `j` is at position `m - 1 - j`. Read as a big-endian number,
+// a state then has the first pattern symbol in its least significant bit, as in the textbook formulation, and moving
+// to the next pattern symbol is a shift towards the most significant bit with a carry from the following word.
+
+// Shift-Or search for occurrences with at most `max_mismatches` substituted symbols (Hamming distance). It keeps one
+// state vector per allowed number of mismatches, where a zero bit marks a pattern prefix that matches the text ending
+// at the current symbol.
+class ShiftOrMatcher {
+public:
+  explicit ShiftOrMatcher(std::string_view pattern, std::size_t max_mismatches = 0);
+
+  void feed(std::string_view text, std::vector<Match>& matches);
+
+  // Starts a new stream
+  void reset();
+
+  // Number of symbols consumed since the start of the stream
+  std::size_t position() const;
+
+private:
+  std::size_t _size;
+  BitMatrix _masks;
+  BitMatrix _states;
+  std::size_t _position;
+};
+
+// Myers' bit-vector algorithm for occurrences within edit distance `max_distance`, using the block-based multi-word
+// formulation: vertical deltas of the dynamic programming column are kept as two bit vectors, and the additions
+// carry across words.
+class MyersMatcher {
+public:
+  MyersMatcher(std::string_view pattern, std::size_t max_distance);
+
+  void feed(std::string_view text, std::vector<Match>& matches);
+
+  void reset();
+
+  std::size_t position() const;
+
+private:
+  std::size_t _size;
+  std::size_t _max_distance;
+  BitMatrix _peq;
+  BitSet _positive;
+  BitSet _negative;
+  std::size_t _score;
+  std::size_t _position;
+};
+
+} // namespace ct
@@ -0,0 +1,251 @@
+#include "bitset-matrix.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ct {
+
+namespace {
+
+using detail::Word;
+using detail::WORD_BITS;
+
+using Block = std::array<Word, WORD_BITS>;
+
+// Rows of `right` combined by one lookup table
+constexpr std::size_t TABLE_BITS = 8;
+// Width of the result columns processed at once, so that a table of 256 rows (32 KiB) stays in L1
+constexpr std::size_t STRIPE_WORDS = 16;
+
+// Transposes a 64x64 block in place by swapping off-diagonal quadrants of halving size
+void transpose_block(Block& block) {
+  Word mask = 0x00000000FFFFFFFF;
+  for (std::size_t width = WORD_BITS / 2; width != 0; width >>= 1, mask ^= mask << width) {
+    for (std::size_t k = 0; k < WORD_BITS; k = ((k | width) + 1) & ~width) {
+      Word t = (block[k] ^ (block[k | width] >> width)) & mask;
+      block[k] ^= t;
+      block[k | width] ^= t << width;
+    }
+  }
+}
+
+} // namespace
+
+BitMatrix::BitMatrix()
+    : _data(nullptr)
+    , _rows(0)
+    , _columns(0)
+    , _stride(0) {}
+
+BitMatrix::BitMatrix(std::size_t rows, std::size_t columns, bool value)
+    : _data(allocate(rows * detail::word_count(columns)))
+    , _rows(rows)
+    , _columns(columns)
+    , _stride(detail::word_count(columns)) {
+  std::fill_n(_data, _rows * _stride, value ? detail::ALL_ONES : Word(0));
+  if (value && _columns % WORD_BITS != 0) {
+    for (std::size_t row = 0; row < _rows; ++row) {
+      row_data(row)[_stride - 1] &= detail::range_mask(0, _columns % WORD_BITS);
+    }
+  }
+}
+
+BitMatrix::BitMatrix(const BitMatrix& other)
+    : _data(allocate(other._rows * other._stride))
+    , _rows(other._rows)
+    , _columns(other._columns)
+    , _stride(other._stride) {
+  std::copy_n(other._data, _rows * _stride, _data);
+}
+
+BitMatrix BitMatrix::identity(std::size_t size) {
+  BitMatrix result(size, size, false);
+  for (std::size_t i = 0; i < size; ++i) {
+    result.row_data(i)[i / WORD_BITS] = detail::bit_mask(i % WORD_BITS);
+  }
+  return result;
+}
+
+BitMatrix& BitMatrix::operator=(const BitMatrix& other) & {
+  if (this != &other) {
+    BitMatrix(other).swap(*this);
+  }
+  return *this;
+}
+
+BitMatrix::~BitMatrix() {
+  deallocate(_data);
+}
+
+void BitMatrix::swap(BitMatrix& other) {
+  std::swap(_data, other._data);
+  std::swap(_rows, other._rows);
+  std::swap(_columns, other._columns);
+  std::swap(_stride, other._stride);
+}
+
+std::size_t BitMatrix::rows() const {
+  return _rows;
+}
+
+std::size_t BitMatrix::columns() const {
+  return _columns;
+}
+
+BitMatrix::View BitMatrix::operator[](std::size_t row) {
+  return {row_data(row), 0, _columns};
+}
+
+BitMatrix::ConstView BitMatrix::operator[](std::size_t row) const {
+  return {row_data(row), 0, _columns};
+}
+
+BitMatrix BitMatrix::transposed() const {
+  BitMatrix result(_columns, _rows, false);
+  Block block;
+  for (std::size_t row = 0; row < _rows; row += WORD_BITS) {
+    std::size_t height = std::min(WORD_BITS, _rows - row);
+    for (std::size_t word = 0; word < _stride; ++word) {
+      for (std::size_t i = 0; i < height; ++i) {
+        block[i] = row_data(row + i)[word];
+      }
+      std::fill(block.begin() + static_cast<std::ptrdiff_t>(height), block.end(), Word(0));
+      transpose_block(block);
+      std::size_t width = std::min(WORD_BITS, _columns - word * WORD_BITS);
+      for (std::size_t i = 0; i < width; ++i) {
+        result.row_data(word * WORD_BITS + i)[row / WORD_BITS] = block[i];
+      }
+    }
+  }
+  return result;
+}
+
+// Rows at and below the current rank are zero in all columns before the current one, so row operations start at
+// the word holding the pivot column
+std::size_t BitMatrix::eliminate() & {
+  std::size_t rank = 0;
+  for (std::size_t column = 0; column < _columns && rank < _rows; ++column) {
+    std::size_t word = column / WORD_BITS;
+    Word mask = detail::bit_mask(column % WORD_BITS);
+    std::size_t pivot = rank;
+    while (pivot < _rows && (row_data(pivot)[word] & mask) == 0) {
+      ++pivot;
+    }
+    if (pivot == _rows) {
+      continue;
+    }
+    if (pivot != rank) {
+      std::swap_ranges(row_data(pivot) + word, row_data(pivot) + _stride, row_data(rank) + word);
+    }
+    const Word* source = row_data(rank);
+    for (std::size_t row = 0; row < _rows; ++row) {
+      Word* target = row_data(row);
+      if (row != rank && (target[word] & mask) != 0) {
+        for (std::size_t i = word; i < _stride; ++i) {
+          target[i] ^= source[i];
+        }
+      }
+    }
+    ++rank;
+  }
+  return rank;
+}
+
+std::size_t BitMatrix::rank() const {
+  BitMatrix copy(*this);
+  return copy.eliminate();
+}
+
+// The result is built in vertical stripes. For each group of rows of `right`, `table[index]` holds the combination
+// of the rows selected by the bits of `index` restricted to the stripe, built from a smaller index in one step.
+template <typename Op>
+BitMatrix BitMatrix::product(const BitMatrix& left, const BitMatrix& right, Op op) {
+  if (left._columns != right._rows) {
+    throw std::invalid_argument("matrix dimensions do not match");
+  }
+  BitMatrix result(left._rows, right._columns, false);
+  std::vector<Word> table((std::size_t(1) << TABLE_BITS) * STRIPE_WORDS);
+  for (std::size_t stripe = 0; stripe < right._stride; stripe += STRIPE_WORDS) {
+    std::size_t width = std::min(STRIPE_WORDS, right._stride - stripe);
+    for (std::size_t group = 0; group < left._columns; group += TABLE_BITS) {
+      std::size_t count = std::min(TABLE_BITS, left._columns - group);
+      std::fill_n(table.begin(), width, Word(0));
+      for (std::size_t index = 1; index < (std::size_t(1) << count); ++index) {
+        const Word* base = table.data() + (index & (index - 1)) * width;
+        std::size_t lowest = static_cast<std::size_t>(std::countr_zero(index));
+        const Word* row = right.row_data(group + count - 1 - lowest) + stripe;
+        Word* target = table.data() + index * width;
+        for (std::size_t i = 0; i < width; ++i) {
+          target[i] = op(base[i], row[i]);
+        }
+      }
+      for (std::size_t row = 0; row < left._rows; ++row) {
+        std::size_t index = detail::load_bits(left.row_data(row), group, count) >> (WORD_BITS - count);
+        if (index != 0) {
+          const Word* source = table.data() + index * width;
+          Word* target = result.row_data(row) + stripe;
+          for (std::size_t i = 0; i < width; ++i) {
+            target[i] = op(target[i], source[i]);
+          }
+        }
+      }
+    }
+  }
+  return result;
+}
+
+bool operator==(const BitMatrix& left, const BitMatrix& right) {
+  return left._rows == right._rows && left._columns == right._columns &&
+         std::equal(left._data, left._data + left._rows * left._stride, right._data);
+}
+
+BitMatrix multiply(const BitMatrix& left, const BitMatrix& right) {
+  return BitMatrix::product(left, right, std::bit_xor<>());
+}
+
+BitMatrix boolean_multiply(const BitMatrix& left, const BitMatrix& right) {
+  return BitMatrix::product(left, right, std::bit_or<>());
+}
+
+bool operator!=(const BitMatrix& left, const BitMatrix& right) {
+  return !(left == right);
+}
+
+BitMatrix operator*(const BitMatrix& left, const BitMatrix& right) {
+  return multiply(left, right);
+}
+
+void swap(BitMatrix& lhs, BitMatrix& rhs) {
+  lhs.swap(rhs);
+}
+
+BitMatrix::Word* BitMatrix::allocate(std::size_t words) {
+  if (words == 0) {
+    return nullptr;
+  }
+  detail::record(detail::Stat::ALLOCATIONS);
+  detail::record(detail::Stat::ALLOCATED_BYTES, words * sizeof(Word));
+  return new Word[words];
+}
+
+void BitMatrix::deallocate(Word* data) {
+  if (data != nullptr) {
+    detail::record(detail::Stat::DEALLOCATIONS);
+  }
+  delete[] data;
+}
+
+BitMatrix::Word* BitMatrix::row_data(std::size_t row) {
+  return _data + row * _stride;
+}
+
+const BitMatrix::Word* BitMatrix::row_data(std::size_t row) const {
+  return _data + row * _stride;
+}
+
+} // namespace ct
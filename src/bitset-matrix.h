@@ -0,0 +1,75 @@
+#pragma once
+
+#include "bitset.h"
+#include "bitset-words.h"
+
+#include <cstddef>
+
+namespace ct {
+
+// Dense matrix of bits with contiguous row-major storage. Every row starts at a word boundary and is exposed as a
+// `BitSet::View`, so row operations run at word granularity. Arithmetic is over GF(2) unless stated otherwise.
+class BitMatrix {
+public:
+  using Word = detail::Word;
+  using View = BitSet::View;
+  using ConstView = BitSet::ConstView;
+
+  BitMatrix();
+  BitMatrix(std::size_t rows, std::size_t columns, bool value);
+  BitMatrix(const BitMatrix& other);
+
+  static BitMatrix identity(std::size_t size);
+
+  BitMatrix& operator=(const BitMatrix& other) &;
+
+  ~BitMatrix();
+
+  void swap(BitMatrix& other);
+
+  std::size_t rows() const;
+  std::size_t columns() const;
+
+  View operator[](std::size_t row);
+  ConstView operator[](std::size_t row) const;
+
+  // Transposes 64x64 blocks in registers, touching every source and destination word once
+  BitMatrix transposed() const;
+
+  // Brings the matrix to reduced row echelon form in place and returns its rank
+  std::size_t eliminate() &;
+  std::size_t rank() const;
+
+  friend bool operator==(const BitMatrix& left, const BitMatrix& right);
+
+  // Product over GF(2) (`multiply`) and over the boolean semiring (`boolean_multiply`), e.g. composition of
+  // relations. Both use the method of Four Russians: rows of `right` are taken in groups of eight, all their
+  // combinations are tabulated, and every row of the result is then updated with a single table lookup per group.
+  // `std::invalid_argument` is thrown unless `left` has as many columns as `right` has rows.
+  friend BitMatrix multiply(const BitMatrix& left, const BitMatrix& right);
+  friend BitMatrix boolean_multiply(const BitMatrix& left, const BitMatrix& right);
+
+private:
+  static Word* allocate(std::size_t words);
+  static void deallocate(Word* data);
+
+  Word* row_data(std::size_t row);
+  const Word* row_data(std::size_t row) const;
+
+  template <typename Op>
+  static BitMatrix product(const BitMatrix& left, const BitMatrix& right, Op op);
+
+private:
+  Word* _data;
+  std::size_t _rows;
+  std::size_t _columns;
+  std::size_t _stride;
+};
+
+bool operator!=(const BitMatrix& left, const BitMatrix& right);
+
+BitMatrix operator*(const BitMatrix& left, const BitMatrix& right);
+
+void swap(BitMatrix& lhs, BitMatrix& rhs);
+
+} // namespace ct
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "bitset.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+namespace ct {
+
+// Four independent xoshiro256++ generators advanced together. The state is stored lane by lane, so that a step of all
+// lanes is the same operation on four adjacent words and can be compiled to vector instructions. The sequence is fully
+// determined by the seed.
+class Xoshiro256x4 {
+public:
+  using result_type = std::uint64_t;
+
+  static constexpr std::size_t LANES = 4;
+
+  // The state is expanded from the seed with splitmix64, as recommended by the authors of xoshiro
+  explicit Xoshiro256x4(std::uint64_t seed) {
+    for (std::array<std::uint64_t, LANES>& row : _state) {
+      for (std::uint64_t& lane : row) {
+        seed += 0x9e37'79b9'7f4a'7c15;
+        std::uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xbf58'476d'1ce4'e5b9;
+        z = (z ^ (z >> 27)) * 0x94d0'49bb'1331'11eb;
+        lane = z ^ (z >> 31);
+      }
+    }
+  }
+
+  static constexpr result_type min() {
+    return 0;
+  }
+
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    if (_next == LANES) {
+      step(_state, _output.data());
+      _next = 0;
+    }
+    return _output[_next++];
+  }
+
+  // Same as filling `out` with consecutive calls. Full steps of all lanes are stored directly, working on a local copy
+  // of the state that the compiler can keep in registers.
+  void generate(std::span<result_type> out) {
+    std::size_t i = 0;
+    for (; i < out.size() && _next != LANES; ++i) {
+      out[i] = _output[_next++];
+    }
+    State state = _state;
+    for (; i + LANES <= out.size(); i += LANES) {
+      step(state, out.data() + i);
+    }
+    _state = state;
+    for (; i < out.size(); ++i) {
+      out[i] = (*this)();
+    }
+  }
+
+private:
+  using State = std::array<std::array<std::uint64_t, LANES>, 4>;
+
+  static void step(State& state, std::uint64_t* out) {
+    for (std::size_t lane = 0; lane < LANES; ++lane) {
+      out[lane] = std::rotl(state[0][lane] + state[3][lane], 23) + state[0][lane];
+      std::uint64_t t = state[1][lane] << 17;
+      state[2][lane] ^= state[0][lane];
+      state[3][lane] ^= state[1][lane];
+      state[1][lane] ^= state[2][lane];
+      state[0][lane] ^= state[3][lane];
+      state[2][lane] ^= t;
+      state[3][lane] = std::rotl(state[3][lane], 45);
+    }
+  }
+
+private:
+  State _state;
+  std::array<std::uint64_t, LANES> _output{};
+  std::size_t _next = LANES;
+};
+
+namespace detail {
+
+// Probabilities are rounded to this many binary digits
+inline constexpr std::size_t RANDOM_PRECISION = 32;
+
+// Words generated and combined at once
+inline constexpr std::size_t RANDOM_BLOCK_WORDS = 64;
+
+template <typename URBG>
+Word random_word(URBG& rng) {
+  static_assert(URBG::min() == 0, "the generator must produce uniformly random words");
+  if constexpr (URBG::max() == std::numeric_limits<std::uint64_t>::max()) {
+    return static_cast<Word>(rng());
+  } else {
+    static_assert(URBG::max() == std::numeric_limits<std::uint32_t>::max(), "unsupported range of the generator");
+    auto high = static_cast<Word>(rng());
+    return (high << 32) | static_cast<Word>(rng());
+  }
+}
+
+template <typename URBG>
+void random_words(URBG& rng, std::span<Word> out) {
+  if constexpr (requires { rng.generate(out); }) {
+    rng.generate(out);
+  } else {
+    for (Word& word : out) {
+      word = random_word(rng);
+    }
+  }
+}
+
+} // namespace detail
+
+// Replaces every bit of the view with an independent random bit that is one with probability `p`, rounded to 32
+// binary digits. With `p = 0.5` every word is taken from the generator as is. Otherwise the digits of `p` are walked
+// from the lowest set one upwards, combining a fresh random word into the result with OR for a one digit and with AND
+// for a zero digit: each step halves the probability of a one and adds the digit to it. This takes at most 32 random
+// words per 64 bits, fewer for probabilities with short binary expansions. Words are produced in blocks, so that
+// the combining loops run over arrays. The result depends only on the generator state and the size of the view, so a
+// seeded generator gives reproducible bits.
+template <typename URBG>
+void fill_random(const BitSet::View& view, URBG& rng, double p) {
+  constexpr auto ONE = std::uint64_t(1) << detail::RANDOM_PRECISION;
+  auto digits = static_cast<std::uint64_t>(std::llround(std::clamp(p, 0.0, 1.0) * static_cast<double>(ONE)));
+  if (digits == 0 || digits == ONE) {
+    detail::fill(view.data(), view.offset(), view.size(), digits == ONE);
+    return;
+  }
+  auto lowest = static_cast<std::size_t>(std::countr_zero(digits));
+  std::array<detail::Word, detail::RANDOM_BLOCK_WORDS> block;
+  std::array<detail::Word, detail::RANDOM_BLOCK_WORDS> next;
+  constexpr std::size_t BLOCK_BITS = detail::RANDOM_BLOCK_WORDS * detail::WORD_BITS;
+  for (std::size_t position = 0; position < view.size(); position += BLOCK_BITS) {
+    std::size_t bits = std::min(BLOCK_BITS, view.size() - position);
+    std::size_t words = detail::word_count(bits);
+    detail::random_words(rng, std::span(block).first(words));
+    for (std::size_t digit = lowest + 1; digit < detail::RANDOM_PRECISION; ++digit) {
+      detail::random_words(rng, std::span(next).first(words));
+      if (((digits >> digit) & 1) != 0) {
+        for (std::size_t i = 0; i < words; ++i) {
+          block[i] |= next[i];
+        }
+      } else {
+        for (std::size_t i = 0; i < words; ++i) {
+          block[i] &= next[i];
+        }
+      }
+    }
+    detail::transform(view.data(), view.offset() + position, block.data(), 0, bits, [](detail::Word, detail::Word src) {
+      return src;
+    });
+  }
+}
+
+} // namespace ct
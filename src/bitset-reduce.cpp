@@ -0,0 +1,264 @@
+#include "bitset-reduce.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <functional>
+#include <vector>
+
+namespace ct {
+
+namespace {
+
+using detail::Word;
+using detail::WORD_BITS;
+
+// Words of the result combined at once. A threshold over a thousand inputs keeps ten counter planes of this size,
+// which still fit into L1 together with the input block.
+constexpr std::size_t BLOCK_WORDS = 256;
+
+// Inputs starting at a word boundary are combined this many at a time
+constexpr std::size_t GROUP = 4;
+
+using Block = std::array<Word, BLOCK_WORDS>;
+
+struct Assign {
+  Word operator()(Word, Word src) const {
+    return src;
+  }
+};
+
+// Combines `count` logical words of `view`, starting with word `first`, into `block`; returns their union so that
+// callers can detect an all-zero block for free
+template <typename Op>
+Word combine(const BitSet::ConstView& view, std::size_t first, std::size_t count, Word* block, Op op) {
+  std::size_t full_words = std::min(count, view.size() / WORD_BITS - first);
+  const Word* data = view.data() + first;
+  std::size_t shift = view.offset();
+  Word any = 0;
+  if (shift == 0) {
+    for (std::size_t i = 0; i < full_words; ++i) {
+      block[i] = op(block[i], data[i]);
+      any |= block[i];
+    }
+  } else {
+    for (std::size_t i = 0; i < full_words; ++i) {
+      block[i] = op(block[i], detail::funnel_load(data + i, shift));
+      any |= block[i];
+    }
+  }
+  if (full_words < count) {
+    std::size_t position = (first + full_words) * WORD_BITS;
+    Word rest = detail::load_bits(view.data(), shift + position, view.size() - position);
+    block[full_words] = op(block[full_words], rest);
+    any |= block[full_words];
+  }
+  return any;
+}
+
+// Same as `combine` for `N` word-aligned views at once, so that the block is loaded and stored once per group.
+// With `assign`, the previous contents of the block are ignored.
+template <std::size_t N, typename Op>
+Word combine_aligned(
+    const BitSet::ConstView* views,
+    std::size_t first,
+    std::size_t count,
+    Word* block,
+    Op op,
+    bool assign
+) {
+  std::size_t full_words = std::min(count, views[0].size() / WORD_BITS - first);
+  std::array<const Word*, N> data;
+  for (std::size_t j = 0; j < N; ++j) {
+    data[j] = views[j].data() + first;
+  }
+  Word any = 0;
+  for (std::size_t i = 0; i < full_words; ++i) {
+    Word value = assign ? data[0][i] : op(block[i], data[0][i]);
+    for (std::size_t j = 1; j < N; ++j) {
+      value = op(value, data[j][i]);
+    }
+    block[i] = value;
+    any |= value;
+  }
+  if (full_words < count) {
+    std::size_t position = (first + full_words) * WORD_BITS;
+    std::size_t rest = views[0].size() - position;
+    Word value = detail::load_bits(views[0].data(), position, rest);
+    value = assign ? value : op(block[full_words], value);
+    for (std::size_t j = 1; j < N; ++j) {
+      value = op(value, detail::load_bits(views[j].data(), position, rest));
+    }
+    block[full_words] = value;
+    any |= value;
+  }
+  return any;
+}
+
+// Combines the views starting with `views[i]` into the block and returns how many of them were used
+template <typename Op>
+std::size_t combine_next(
+    std::span<const BitSet::ConstView> views,
+    std::size_t i,
+    std::size_t first,
+    std::size_t count,
+    Word* block,
+    Op op,
+    Word& any
+) {
+  std::size_t group = 0;
+  while (group < GROUP && i + group < views.size() && views[i + group].offset() == 0) {
+    ++group;
+  }
+  bool assign = (i == 0);
+  switch (group) {
+    case 4:
+      any = combine_aligned<4>(&views[i], first, count, block, op, assign);
+      return 4;
+    case 3:
+      any = combine_aligned<3>(&views[i], first, count, block, op, assign);
+      return 3;
+    case 2:
+      any = combine_aligned<2>(&views[i], first, count, block, op, assign);
+      return 2;
+    default:
+      any = assign ? combine(views[i], first, count, block, Assign()) : combine(views[i], first, count, block, op);
+      return 1;
+  }
+}
+
+// Stores the block to `out` if it is not null, and counts its bits otherwise
+std::size_t finish_block(const Word* block, std::size_t count, Word* out) {
+  if (out != nullptr) {
+    std::copy_n(block, count, out);
+    return 0;
+  }
+  std::size_t result = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    result += static_cast<std::size_t>(std::popcount(block[i]));
+  }
+  return result;
+}
+
+// Writes the result to `out`, or returns its number of set bits if `out` is null
+template <typename Op>
+std::size_t reduce(std::span<const BitSet::ConstView> views, Word* out, Op op, bool stop_on_zero) {
+  std::size_t words = detail::word_count(views.front().size());
+  std::size_t result = 0;
+  Block block;
+  for (std::size_t first = 0; first < words; first += BLOCK_WORDS) {
+    std::size_t count = std::min(BLOCK_WORDS, words - first);
+    Word any = detail::ALL_ONES;
+    for (std::size_t i = 0; i < views.size() && (any != 0 || !stop_on_zero);) {
+      i += combine_next(views, i, first, count, block.data(), op, any);
+    }
+    result += finish_block(block.data(), count, out == nullptr ? nullptr : out + first);
+  }
+  return result;
+}
+
+// Expects `0 < threshold <= views.size()`. Keeps a bit-sliced counter per bit: plane `p` holds bit `p` of every
+// counter. Adding an input is a ripple-carry addition of a one-bit number that stops as soon as no carries are left,
+// and the final comparison with the threshold walks the planes from the most significant one.
+std::size_t count_at_least(std::span<const BitSet::ConstView> views, std::size_t threshold, Word* out) {
+  std::size_t words = detail::word_count(views.front().size());
+  auto planes = static_cast<std::size_t>(std::bit_width(views.size()));
+  std::vector<Word> counters(planes * BLOCK_WORDS);
+  std::size_t result = 0;
+  Block carry;
+  Block block;
+  for (std::size_t first = 0; first < words; first += BLOCK_WORDS) {
+    std::size_t count = std::min(BLOCK_WORDS, words - first);
+    std::fill(counters.begin(), counters.end(), Word(0));
+    for (const BitSet::ConstView& view : views) {
+      Word any = combine(view, first, count, carry.data(), Assign());
+      for (std::size_t plane = 0; plane < planes && any != 0; ++plane) {
+        Word* counter = counters.data() + plane * BLOCK_WORDS;
+        any = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+          Word next = counter[i] & carry[i];
+          counter[i] ^= carry[i];
+          carry[i] = next;
+          any |= next;
+        }
+      }
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      Word greater = 0;
+      Word equal = detail::ALL_ONES;
+      for (std::size_t plane = planes; plane-- != 0;) {
+        Word counter = counters[plane * BLOCK_WORDS + i];
+        if (((threshold >> plane) & 1) != 0) {
+          equal &= counter;
+        } else {
+          greater |= equal & counter;
+          equal &= ~counter;
+        }
+      }
+      block[i] = greater | equal;
+    }
+    result += finish_block(block.data(), count, out == nullptr ? nullptr : out + first);
+  }
+  return result;
+}
+
+template <typename Op>
+BitSet materialize(std::span<const BitSet::ConstView> views, Op op, bool stop_on_zero) {
+  if (views.empty()) {
+    return BitSet();
+  }
+  BitSet result(views.front().size(), false);
+  reduce(views, BitSet::View(result).data(), op, stop_on_zero);
+  return result;
+}
+
+} // namespace
+
+BitSet and_all(std::span<const BitSet::ConstView> views) {
+  return materialize(views, std::bit_and<>(), true);
+}
+
+BitSet or_all(std::span<const BitSet::ConstView> views) {
+  return materialize(views, std::bit_or<>(), false);
+}
+
+BitSet xor_all(std::span<const BitSet::ConstView> views) {
+  return materialize(views, std::bit_xor<>(), false);
+}
+
+BitSet threshold_count(std::span<const BitSet::ConstView> views, std::size_t threshold) {
+  if (views.empty()) {
+    return BitSet();
+  }
+  std::size_t size = views.front().size();
+  if (threshold == 0 || threshold > views.size()) {
+    return BitSet(size, threshold == 0);
+  }
+  BitSet result(size, false);
+  count_at_least(views, threshold, BitSet::View(result).data());
+  return result;
+}
+
+std::size_t count_and_all(std::span<const BitSet::ConstView> views) {
+  return views.empty() ? 0 : reduce(views, nullptr, std::bit_and<>(), true);
+}
+
+std::size_t count_or_all(std::span<const BitSet::ConstView> views) {
+  return views.empty() ? 0 : reduce(views, nullptr, std::bit_or<>(), false);
+}
+
+std::size_t count_xor_all(std::span<const BitSet::ConstView> views) {
+  return views.empty() ? 0 : reduce(views, nullptr, std::bit_xor<>(), false);
+}
+
+std::size_t count_threshold(std::span<const BitSet::ConstView> views, std::size_t threshold) {
+  if (views.empty() || threshold > views.size()) {
+    return 0;
+  }
+  if (threshold == 0) {
+    return views.front().size();
+  }
+  return count_at_least(views, threshold, nullptr);
+}
+
+} // namespace ct
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "bitset.h"
+
+#include <cstddef>
+#include <span>
+
+namespace ct {
+
+// Reductions of many bitsets of the same size in a single pass. The result is produced in blocks of 2 KiB: each block
+// is combined across all inputs while it stays in L1, so memory is read once rather than once per pairwise operation.
+// Views may start at any offset. An empty list of inputs gives an empty result.
+
+BitSet and_all(std::span<const BitSet::ConstView> views);
+BitSet or_all(std::span<const BitSet::ConstView> views);
+BitSet xor_all(std::span<const BitSet::ConstView> views);
+
+// Bits set in at least `threshold` of the inputs, counted with bit-sliced adders
+BitSet threshold_count(std::span<const BitSet::ConstView> views, std::size_t threshold);
+
+// Number of set bits in the corresponding result, computed without storing it. `count_and_all` skips the remaining
+// inputs of a block as soon as the block becomes zero.
+std::size_t count_and_all(std::span<const BitSet::ConstView> views);
+std::size_t count_or_all(std::span<const BitSet::ConstView> views);
+std::size_t count_xor_all(std::span<const BitSet::ConstView> views);
+std::size_t count_threshold(std::span<const BitSet::ConstView> views, std::size_t threshold);
+
+} // namespace ct
@@ -1,7 +1,75 @@
 #pragma once
 
+#include "bitset-stats.h"
+
+#include <type_traits>
+
 namespace ct {
 
-// TODO BitSet reference
+class BitSet;
+
+template <typename W>
+class BitIterator;
+
+template <typename W>
+class BitView;
+
+// Proxy for a single bit. `W` is either `Word` or `const Word`, the latter giving a read-only reference.
+template <typename W>
+class BitReference {
+  using MutableWord = std::remove_const_t<W>;
+
+public:
+  BitReference() = delete;
+
+  template <typename U>
+  BitReference(const BitReference<U>& other)
+    requires (std::is_const_v<W> && !std::is_const_v<U>)
+      : _word(other._word)
+      , _mask(other._mask) {}
+
+  operator bool() const {
+    return (*_word & _mask) != 0;
+  }
+
+  const BitReference& operator=(bool value) const
+    requires (!std::is_const_v<W>)
+  {
+    detail::record(detail::Stat::REFERENCE_WRITES);
+    if (value) {
+      *_word |= _mask;
+    } else {
+      *_word &= ~_mask;
+    }
+    return *this;
+  }
+
+  void flip() const
+    requires (!std::is_const_v<W>)
+  {
+    detail::record(detail::Stat::REFERENCE_WRITES);
+    *_word ^= _mask;
+  }
+
+private:
+  BitReference(W* word, MutableWord mask)
+      : _word(word)
+      , _mask(mask) {}
+
+private:
+  W* _word;
+  MutableWord _mask;
+
+  friend class BitSet;
+
+  template <typename>
+  friend class BitReference;
+
+  template <typename>
+  friend class BitIterator;
+
+  template <typename>
+  friend class BitView;
+};
 
 } // namespace ct
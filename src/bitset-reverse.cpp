@@ -0,0 +1,44 @@
+#include "bitset-reverse.h"
+
+namespace ct::detail {
+
+bool equal_reversed(
+    const Word* lhs,
+    std::size_t lhs_offset,
+    const Word* rhs,
+    std::size_t rhs_offset,
+    std::size_t size
+) {
+  for (std::size_t position = 0; position < size; position += WORD_BITS) {
+    std::size_t count = std::min(WORD_BITS, size - position);
+    Word value = load_reversed(rhs, rhs_offset + size - position - count, count);
+    if (load_bits(lhs, lhs_offset + position, count) != value) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The two ends move towards each other a word at a time. Less than two words are left in the middle: their halves
+// are exchanged the same way, and the middle bit of an odd remainder stays in place.
+void reverse(Word* data, std::size_t offset, std::size_t size) {
+  std::size_t first = offset;
+  std::size_t last = offset + size;
+  while (last - first >= 2 * WORD_BITS) {
+    last -= WORD_BITS;
+    Word head = load_reversed(data, first, WORD_BITS);
+    Word tail = load_reversed(data, last, WORD_BITS);
+    store_bits(data, first, WORD_BITS, tail);
+    store_bits(data, last, WORD_BITS, head);
+    first += WORD_BITS;
+  }
+  std::size_t half = (last - first) / 2;
+  if (half != 0) {
+    Word head = load_reversed(data, first, half);
+    Word tail = load_reversed(data, last - half, half);
+    store_bits(data, first, half, tail);
+    store_bits(data, last - half, half, head);
+  }
+}
+
+} // namespace ct::detail
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "bitset-words.h"
+
+#include <algorithm>
+#include <cstddef>
+
+// Reversal of the logical bit order of a range, one word at a time
+namespace ct::detail {
+
+// Reverses the order of the bytes of the word, keeping the order of bits inside every byte
+constexpr Word byte_swap(Word word) {
+  word = ((word >> 8) & 0x00ff'00ff'00ff'00ff) | ((word & 0x00ff'00ff'00ff'00ff) << 8);
+  word = ((word >> 16) & 0x0000'ffff'0000'ffff) | ((word & 0x0000'ffff'0000'ffff) << 16);
+  return (word >> 32) | (word << 32);
+}
+
+// Reverses the order of bits inside every byte of the word
+constexpr Word reverse_bytes(Word word) {
+  word = ((word >> 1) & 0x5555'5555'5555'5555) | ((word & 0x5555'5555'5555'5555) << 1);
+  word = ((word >> 2) & 0x3333'3333'3333'3333) | ((word & 0x3333'3333'3333'3333) << 2);
+  return ((word >> 4) & 0x0f0f'0f0f'0f0f'0f0f) | ((word & 0x0f0f'0f0f'0f0f'0f0f) << 4);
+}
+
+constexpr Word reverse_word(Word word) {
+  return byte_swap(reverse_bytes(word));
+}
+
+// Returns the `count` bits (`0 < count <= WORD_BITS`) starting at `position` in reverse order, placed in the most
+// significant bits
+inline Word load_reversed(const Word* data, std::size_t position, std::size_t count) {
+  return reverse_word(load_bits(data, position, count)) << (WORD_BITS - count);
+}
+
+// Replaces every bit `d` at position `i` of the destination range with `op(d, s)`, where `s` is the source bit at
+// position `size - 1 - i`. The ranges must not overlap.
+template <typename Op>
+void transform_reversed(
+    Word* dst,
+    std::size_t dst_offset,
+    const Word* src,
+    std::size_t src_offset,
+    std::size_t size,
+    Op op
+) {
+  for (std::size_t position = 0; position < size; position += WORD_BITS) {
+    std::size_t count = std::min(WORD_BITS, size - position);
+    Word value = load_reversed(src, src_offset + size - position - count, count);
+    std::size_t target = dst_offset + position;
+    store_bits(dst, target, count, op(load_bits(dst, target, count), value));
+  }
+}
+
+// Whether the range of `lhs` equals the range of `rhs` read backwards
+bool equal_reversed(
+    const Word* lhs,
+    std::size_t lhs_offset,
+    const Word* rhs,
+    std::size_t rhs_offset,
+    std::size_t size
+);
+
+// Reverses the range in place by exchanging reversed words from both of its ends
+void reverse(Word* data, std::size_t offset, std::size_t size);
+
+} // namespace ct::detail
@@ -0,0 +1,88 @@
+#include "bitset-reversed.h"
+
+#include <functional>
+
+namespace ct {
+
+namespace {
+
+template <typename Op>
+void combine(const BitSet::View& target, const ReversedConstView& source, Op op) {
+  const BitSet::ConstView& base = source.base();
+  detail::transform_reversed(target.data(), target.offset(), base.data(), base.offset(), base.size(), op);
+}
+
+} // namespace
+
+ReversedConstView::ReversedConstView(const BitSet::ConstView& base)
+    : _base(base) {}
+
+std::size_t ReversedConstView::size() const {
+  return _base.size();
+}
+
+bool ReversedConstView::empty() const {
+  return _base.empty();
+}
+
+bool ReversedConstView::operator[](std::size_t index) const {
+  return _base[_base.size() - 1 - index];
+}
+
+const BitSet::ConstView& ReversedConstView::base() const {
+  return _base;
+}
+
+bool ReversedConstView::all() const {
+  return _base.all();
+}
+
+bool ReversedConstView::any() const {
+  return _base.any();
+}
+
+std::size_t ReversedConstView::count() const {
+  return _base.count();
+}
+
+bool operator==(const ReversedConstView& left, const ReversedConstView& right) {
+  return left.base() == right.base();
+}
+
+bool operator==(const ReversedConstView& left, const BitSet::ConstView& right) {
+  const BitSet::ConstView& base = left.base();
+  return base.size() == right.size() &&
+         detail::equal_reversed(right.data(), right.offset(), base.data(), base.offset(), base.size());
+}
+
+const BitSet::View& operator&=(const BitSet::View& target, const ReversedConstView& source) {
+  combine(target, source, std::bit_and<>());
+  return target;
+}
+
+const BitSet::View& operator|=(const BitSet::View& target, const ReversedConstView& source) {
+  combine(target, source, std::bit_or<>());
+  return target;
+}
+
+const BitSet::View& operator^=(const BitSet::View& target, const ReversedConstView& source) {
+  combine(target, source, std::bit_xor<>());
+  return target;
+}
+
+BitSet& operator&=(BitSet& target, const ReversedConstView& source) {
+  target.subview() &= source;
+  return target;
+}
+
+BitSet& operator|=(BitSet& target, const ReversedConstView& source) {
+  target.subview() |= source;
+  return target;
+}
+
+BitSet& operator^=(BitSet& target, const ReversedConstView& source) {
+  target.subview() ^= source;
+  return target;
+}
+
+} // namespace ct
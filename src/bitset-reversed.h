@@ -0,0 +1,44 @@
+#pragma once
+
+#include "bitset.h"
+
+#include <cstddef>
+
+namespace ct {
+
+// Read-only view of another view with the bits in reverse order: position `i` refers to position `size() - 1 - i` of
+// the base. Nothing is copied; bulk operations read the base one word at a time and reverse every word on the fly.
+class ReversedConstView {
+public:
+  ReversedConstView() = default;
+  explicit ReversedConstView(const BitSet::ConstView& base);
+
+  std::size_t size() const;
+  bool empty() const;
+
+  bool operator[](std::size_t index) const;
+
+  // The view being reversed
+  const BitSet::ConstView& base() const;
+
+  bool all() const;
+  bool any() const;
+  std::size_t count() const;
+
+private:
+  BitSet::ConstView _base;
+};
+
+bool operator==(const ReversedConstView& left, const ReversedConstView& right);
+bool operator==(const ReversedConstView& left, const BitSet::ConstView& right);
+
+// Combine the target with the reversed bits; the target must have the same size and must not overlap the base
+const BitSet::View& operator&=(const BitSet::View& target, const ReversedConstView& source);
+const BitSet::View& operator|=(const BitSet::View& target, const ReversedConstView& source);
+const BitSet::View& operator^=(const BitSet::View& target, const ReversedConstView& source);
+
+BitSet& operator&=(BitSet& target, const ReversedConstView& source);
+BitSet& operator|=(BitSet& target, const ReversedConstView& source);
+BitSet& operator^=(BitSet& target, const ReversedConstView& source);
+
+} // namespace ct
@@ -0,0 +1,78 @@
+#include "bitset-runs.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace ct {
+
+void RunIterator::advance(std::size_t from) {
+  std::size_t start = detail::find_bit(_data, _offset, _size, from, _value);
+  std::size_t end = detail::find_bit(_data, _offset, _size, start, !_value);
+  _run = {start, end - start};
+}
+
+} // namespace ct
+
+namespace ct::detail {
+
+namespace {
+
+// Up to a word of the range starting at `position`, with the bits equal to `value` set and zeros past its end
+Word matching_bits(const Word* data, std::size_t offset, std::size_t position, std::size_t count, bool value) {
+  Word chunk = load_bits(data, offset + position, count);
+  return (value ? chunk : ~chunk) & range_mask(0, count);
+}
+
+// Bits of `word` that start a run of at least `length` ones within the word, for `0 < length <= WORD_BITS`. Every
+// step ANDs the word with itself shifted by at most the length covered so far, doubling it.
+Word run_starts(Word word, std::size_t length) {
+  for (std::size_t covered = 1; covered < length;) {
+    std::size_t step = std::min(covered, length - covered);
+    word &= word << step;
+    covered += step;
+  }
+  return word;
+}
+
+} // namespace
+
+std::size_t find_bit(const Word* data, std::size_t offset, std::size_t size, std::size_t from, bool value) {
+  for (std::size_t position = from; position < size; position += WORD_BITS) {
+    std::size_t count = std::min(WORD_BITS, size - position);
+    Word bits = matching_bits(data, offset, position, count, value);
+    if (bits != 0) {
+      return position + static_cast<std::size_t>(std::countl_zero(bits));
+    }
+  }
+  return size;
+}
+
+// A run either crosses into a word from the previous ones, continuing with its leading bits, or lies within the word,
+// or starts with its trailing bits; `run_start` tracks the last kind so that the next word can extend it
+std::size_t find_run(const Word* data, std::size_t offset, std::size_t size, std::size_t length, bool value) {
+  if (length == 0) {
+    return 0;
+  }
+  std::size_t run_start = 0;
+  for (std::size_t position = 0; position < size; position += WORD_BITS) {
+    std::size_t count = std::min(WORD_BITS, size - position);
+    Word bits = matching_bits(data, offset, position, count, value);
+    auto leading = static_cast<std::size_t>(std::countl_one(bits));
+    if (position + leading - run_start >= length) {
+      return run_start;
+    }
+    if (leading == WORD_BITS) {
+      continue;
+    }
+    if (length <= WORD_BITS) {
+      Word starts = run_starts(bits, length);
+      if (starts != 0) {
+        return position + static_cast<std::size_t>(std::countl_zero(starts));
+      }
+    }
+    run_start = position + count - static_cast<std::size_t>(std::countr_one(bits));
+  }
+  return size;
+}
+
+} // namespace ct::detail
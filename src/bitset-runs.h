@@ -0,0 +1,117 @@
+#pragma once
+
+#include "bitset-words.h"
+
+#include <cstddef>
+#include <iterator>
+
+namespace ct {
+
+// Maximal run of equal bits, covering positions `[start, start + length)`
+struct BitRun {
+  std::size_t start = 0;
+  std::size_t length = 0;
+
+  friend bool operator==(const BitRun& lhs, const BitRun& rhs) = default;
+};
+
+// Forward iterator over the maximal runs of ones, or of zeros, of a bit range in ascending order. Each step skips
+// whole words that hold no boundary of the run, so it takes time proportional to the words the run and the gap before
+// it span, not to their bits.
+class RunIterator {
+public:
+  using value_type = BitRun;
+  using reference = const BitRun&;
+  using pointer = const BitRun*;
+  using difference_type = std::ptrdiff_t;
+  using iterator_category = std::forward_iterator_tag;
+
+  RunIterator() = default;
+
+  reference operator*() const {
+    return _run;
+  }
+
+  pointer operator->() const {
+    return &_run;
+  }
+
+  RunIterator& operator++() {
+    advance(_run.start + _run.length);
+    return *this;
+  }
+
+  RunIterator operator++(int) {
+    RunIterator copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  friend bool operator==(const RunIterator& lhs, const RunIterator& rhs) = default;
+
+private:
+  // Iterator at `run`, which is either a run of the range or the empty run at its end
+  RunIterator(const detail::Word* data, std::size_t offset, std::size_t size, bool value, BitRun run)
+      : _data(data)
+      , _offset(offset)
+      , _size(size)
+      , _value(value)
+      , _run(run) {}
+
+  // Moves to the first run starting at or after `from`, or to the end
+  void advance(std::size_t from);
+
+private:
+  const detail::Word* _data = nullptr;
+  std::size_t _offset = 0;
+  std::size_t _size = 0;
+  bool _value = true;
+  BitRun _run;
+
+  friend class RunRange;
+};
+
+// Runs of a view, see `BitView::runs`. Refers to the storage of the view, which must outlive it.
+class RunRange {
+public:
+  RunRange() = default;
+
+  RunIterator begin() const {
+    RunIterator result(_data, _offset, _size, _value, {});
+    result.advance(0);
+    return result;
+  }
+
+  RunIterator end() const {
+    return RunIterator(_data, _offset, _size, _value, {_size, 0});
+  }
+
+private:
+  RunRange(const detail::Word* data, std::size_t offset, std::size_t size, bool value)
+      : _data(data)
+      , _offset(offset)
+      , _size(size)
+      , _value(value) {}
+
+private:
+  const detail::Word* _data = nullptr;
+  std::size_t _offset = 0;
+  std::size_t _size = 0;
+  bool _value = true;
+
+  template <typename>
+  friend class BitView;
+};
+
+} // namespace ct
+
+// Searches for bits and runs of bits one word at a time
+namespace ct::detail {
+
+// Position of the first bit equal to `value` in `[from, size)` of the range, or `size` if there is none
+std::size_t find_bit(const Word* data, std::size_t offset, std::size_t size, std::size_t from, bool value);
+
+// Start of the first run of at least `length` bits equal to `value`, or `size` if there is none
+std::size_t find_run(const Word* data, std::size_t offset, std::size_t size, std::size_t length, bool value);
+
+} // namespace ct::detail
@@ -0,0 +1,114 @@
+#include "bitset-shared.h"
+
+#include <atomic>
+#include <utility>
+
+namespace ct {
+
+SharedBitSet::SharedBitSet()
+    : _bits(std::make_shared<BitSet>()) {}
+
+SharedBitSet::SharedBitSet(std::size_t size, bool value)
+    : _bits(std::make_shared<BitSet>(size, value)) {}
+
+SharedBitSet::SharedBitSet(const ConstView& bits)
+    : _bits(std::make_shared<BitSet>(bits)) {}
+
+void SharedBitSet::swap(SharedBitSet& other) {
+  std::swap(_bits, other._bits);
+}
+
+std::size_t SharedBitSet::size() const {
+  return _bits->size();
+}
+
+bool SharedBitSet::empty() const {
+  return _bits->empty();
+}
+
+SharedBitSet::Reference SharedBitSet::operator[](std::size_t index) {
+  detach();
+  return (*_bits)[index];
+}
+
+SharedBitSet::ConstReference SharedBitSet::operator[](std::size_t index) const {
+  return std::as_const(*_bits)[index];
+}
+
+SharedBitSet::View SharedBitSet::mutable_view() {
+  detach();
+  return *_bits;
+}
+
+SharedBitSet::ConstView SharedBitSet::view() const {
+  return std::as_const(*_bits);
+}
+
+SharedBitSet::operator ConstView() const {
+  return view();
+}
+
+SharedBitSet& SharedBitSet::operator&=(const ConstView& other) & {
+  detach();
+  *_bits &= other;
+  return *this;
+}
+
+SharedBitSet& SharedBitSet::operator|=(const ConstView& other) & {
+  detach();
+  *_bits |= other;
+  return *this;
+}
+
+SharedBitSet& SharedBitSet::operator^=(const ConstView& other) & {
+  detach();
+  *_bits ^= other;
+  return *this;
+}
+
+SharedBitSet& SharedBitSet::flip() & {
+  detach();
+  _bits->flip();
+  return *this;
+}
+
+// Overwriting the whole buffer needs no copy of the old contents
+SharedBitSet& SharedBitSet::set() & {
+  if (unique()) {
+    _bits->set();
+  } else {
+    _bits = std::make_shared<BitSet>(size(), true);
+  }
+  return *this;
+}
+
+SharedBitSet& SharedBitSet::reset() & {
+  if (unique()) {
+    _bits->reset();
+  } else {
+    _bits = std::make_shared<BitSet>(size(), false);
+  }
+  return *this;
+}
+
+// The count is read with relaxed ordering; the fence orders our writes after the reads of the copies that have
+// already released the buffer
+bool SharedBitSet::unique() const {
+  if (_bits.use_count() != 1) {
+    return false;
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return true;
+}
+
+void SharedBitSet::detach() {
+  if (!unique()) {
+    _bits = std::make_shared<BitSet>(*_bits);
+  }
+}
+
+void swap(SharedBitSet& lhs, SharedBitSet& rhs) {
+  lhs.swap(rhs);
+}
+
+} // namespace ct
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "bitset.h"
+
+#include <cstddef>
+#include <memory>
+
+namespace ct {
+
+// Bitset with copy-on-write semantics. Copies share one buffer through an atomic reference count, so handing a
+// snapshot to another thread is O(1); the first modification of a shared copy detaches it with a deep copy of the
+// whole buffer, leaving the other copies untouched.
+//
+// Different objects sharing a buffer can be used from different threads at the same time. Reading through a
+// non-const object also detaches it, so readers should go through `view()` or a const reference. Mutable references
+// and views are invalidated by copying the object: writes through them would be seen by the new copy.
+class SharedBitSet {
+public:
+  using Reference = BitSet::Reference;
+  using ConstReference = BitSet::ConstReference;
+  using View = BitSet::View;
+  using ConstView = BitSet::ConstView;
+
+  SharedBitSet();
+  SharedBitSet(std::size_t size, bool value);
+  explicit SharedBitSet(const ConstView& bits);
+
+  SharedBitSet(const SharedBitSet& other) = default;
+  SharedBitSet& operator=(const SharedBitSet& other) & = default;
+
+  void swap(SharedBitSet& other);
+
+  std::size_t size() const;
+  bool empty() const;
+
+  Reference operator[](std::size_t index);
+  ConstReference operator[](std::size_t index) const;
+
+  View mutable_view();
+  ConstView view() const;
+  operator ConstView() const;
+
+  SharedBitSet& operator&=(const ConstView& other) &;
+  SharedBitSet& operator|=(const ConstView& other) &;
+  SharedBitSet& operator^=(const ConstView& other) &;
+  SharedBitSet& flip() &;
+  SharedBitSet& set() &;
+  SharedBitSet& reset() &;
+
+  // Whether no other copy shares the buffer, so that modifications do not copy it
+  bool unique() const;
+
+private:
+  void detach();
+
+private:
+  std::shared_ptr<BitSet> _bits;
+};
+
+void swap(SharedBitSet& lhs, SharedBitSet& rhs);
+
+} // namespace ct
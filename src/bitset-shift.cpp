@@ -0,0 +1,138 @@
+#include "bitset-shift.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace ct::detail {
+
+namespace {
+
+// Rotations whose shorter side fits into this buffer go through it; longer ones are first reduced by block swaps
+constexpr std::size_t BUFFER_WORDS = 64;
+constexpr std::size_t BUFFER_BITS = BUFFER_WORDS * WORD_BITS;
+
+using Buffer = std::array<Word, BUFFER_WORDS>;
+
+void save(const Word* data, std::size_t position, std::size_t size, Buffer& buffer) {
+  transform(buffer.data(), 0, data, position, size, [](Word, Word src) { return src; });
+}
+
+void restore(Word* data, std::size_t position, std::size_t size, const Buffer& buffer) {
+  transform(data, position, buffer.data(), 0, size, [](Word, Word src) { return src; });
+}
+
+// Copies from higher to lower positions, going through the destination words from the end, so that every source
+// bit is read before the destination reaches it
+void move_backward(Word* data, std::size_t from, std::size_t to, std::size_t size) {
+  std::size_t position = size;
+  std::size_t rest = std::min((to + size) % WORD_BITS, size);
+  if (rest != 0) {
+    position -= rest;
+    store_bits(data, to + position, rest, load_bits(data, from + position, rest));
+  }
+  Word* target = data + (to + position) / WORD_BITS;
+  std::size_t full_words = position / WORD_BITS;
+  std::size_t shift = (from + position) % WORD_BITS;
+  const Word* source = data + (from + position) / WORD_BITS;
+  for (std::size_t i = 1; i <= full_words; ++i) {
+    *(target - i) = funnel_load(source - i, shift);
+  }
+  position -= full_words * WORD_BITS;
+  if (position != 0) {
+    store_bits(data, to, position, load_bits(data, from, position));
+  }
+  std::uint64_t partial_words = (rest != 0) + (position != 0);
+  record_words(Kernel::TRANSFORM, (shift == 0) ? full_words : 0, (shift == 0) ? 0 : full_words, partial_words);
+}
+
+} // namespace
+
+void move_bits(Word* data, std::size_t from, std::size_t to, std::size_t size) {
+  if (size == 0 || from == to) {
+    return;
+  }
+  if (from > to) {
+    transform(data, to, data, from, size, [](Word, Word src) { return src; });
+  } else {
+    move_backward(data, from, to, size);
+  }
+}
+
+void swap_bits(Word* data, std::size_t lhs, std::size_t rhs, std::size_t size) {
+  auto swap_chunk = [data](std::size_t lhs_position, std::size_t rhs_position, std::size_t count) {
+    Word lhs_bits = load_bits(data, lhs_position, count);
+    store_bits(data, lhs_position, count, load_bits(data, rhs_position, count));
+    store_bits(data, rhs_position, count, lhs_bits);
+  };
+  std::size_t position = std::min((WORD_BITS - lhs % WORD_BITS) % WORD_BITS, size);
+  if (position != 0) {
+    swap_chunk(lhs, rhs, position);
+  }
+  // The left range is word-aligned from here on, so only the right one needs funnel shifts
+  Word* lhs_word = data + (lhs + position) / WORD_BITS;
+  for (; size - position >= WORD_BITS; position += WORD_BITS, ++lhs_word) {
+    std::size_t rhs_position = rhs + position;
+    Word rhs_bits = funnel_load(data + rhs_position / WORD_BITS, rhs_position % WORD_BITS);
+    store_bits(data, rhs_position, WORD_BITS, *lhs_word);
+    *lhs_word = rhs_bits;
+  }
+  if (position < size) {
+    swap_chunk(lhs + position, rhs + position, size - position);
+  }
+}
+
+void shift_left(Word* data, std::size_t offset, std::size_t size, std::size_t count) {
+  count = std::min(count, size);
+  move_bits(data, offset + count, offset, size - count);
+  fill(data, offset + size - count, count, false);
+}
+
+void shift_right(Word* data, std::size_t offset, std::size_t size, std::size_t count) {
+  count = std::min(count, size);
+  move_bits(data, offset, offset + count, size - count);
+  fill(data, offset, count, false);
+}
+
+// Rotating `[a b]` into `[b a]`: while both sides are longer than the buffer, the shorter side is swapped with the
+// far end of the longer one, which puts it in its final place and leaves a smaller rotation of the same kind.
+// The last step moves the longer side once and puts the shorter one back from the buffer.
+void rotate_left(Word* data, std::size_t offset, std::size_t size, std::size_t count) {
+  if (size == 0) {
+    return;
+  }
+  count %= size;
+  while (count != 0) {
+    std::size_t rest = size - count;
+    if (count <= BUFFER_BITS || rest <= BUFFER_BITS) {
+      Buffer buffer{};
+      if (count <= rest) {
+        save(data, offset, count, buffer);
+        move_bits(data, offset + count, offset, rest);
+        restore(data, offset + rest, count, buffer);
+      } else {
+        save(data, offset + count, rest, buffer);
+        move_bits(data, offset, offset + rest, count);
+        restore(data, offset, rest, buffer);
+      }
+      return;
+    }
+    if (count <= rest) {
+      swap_bits(data, offset, offset + size - count, count);
+      size -= count;
+    } else {
+      swap_bits(data, offset, offset + count, rest);
+      offset += rest;
+      size -= rest;
+      count -= rest;
+    }
+  }
+}
+
+void rotate_right(Word* data, std::size_t offset, std::size_t size, std::size_t count) {
+  if (size != 0) {
+    rotate_left(data, offset, size, size - count % size);
+  }
+}
+
+} // namespace ct::detail
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "bitset-words.h"
+
+#include <cstddef>
+
+// In-place, size-preserving shifts and rotations of a bit range. Like the other operations, they follow the logical
+// bit order: shifting left by `count` moves the bit at position `i + count` to position `i` and zero-fills the end.
+namespace ct::detail {
+
+// Copies `size` bits from position `from` to position `to` of `data`; the two ranges may overlap
+void move_bits(Word* data, std::size_t from, std::size_t to, std::size_t size);
+
+// Exchanges two non-overlapping ranges of `size` bits
+void swap_bits(Word* data, std::size_t lhs, std::size_t rhs, std::size_t size);
+
+void shift_left(Word* data, std::size_t offset, std::size_t size, std::size_t count);
+void shift_right(Word* data, std::size_t offset, std::size_t size, std::size_t count);
+
+void rotate_left(Word* data, std::size_t offset, std::size_t size, std::size_t count);
+void rotate_right(Word* data, std::size_t offset, std::size_t size, std::size_t count);
+
+} // namespace ct::detail
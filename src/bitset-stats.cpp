@@ -0,0 +1,127 @@
+#include "bitset-stats.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace ct {
+
+namespace detail {
+
+namespace {
+
+constexpr std::size_t STAT_COUNT = static_cast<std::size_t>(Stat::COUNT);
+
+using StatValues = std::array<std::uint64_t, STAT_COUNT>;
+
+// Counters of a single thread. Only the owning thread writes them, so an increment is a relaxed load and store
+// rather than a locked read-modify-write; atomics just make concurrent snapshots well-defined.
+struct ThreadStats {
+  ThreadStats();
+  ~ThreadStats();
+
+  ThreadStats(const ThreadStats&) = delete;
+  ThreadStats& operator=(const ThreadStats&) = delete;
+
+  StatValues load() const {
+    StatValues result{};
+    for (std::size_t i = 0; i < STAT_COUNT; ++i) {
+      result[i] = values[i].load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  std::array<std::atomic<std::uint64_t>, STAT_COUNT> values{};
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<const ThreadStats*> threads;
+  StatValues retired{};  // counters of threads that have already exited
+  StatValues baseline{}; // totals at the moment of the last reset
+
+  StatValues total() const {
+    StatValues result = retired;
+    for (const ThreadStats* thread : threads) {
+      StatValues values = thread->load();
+      for (std::size_t i = 0; i < STAT_COUNT; ++i) {
+        result[i] += values[i];
+      }
+    }
+    return result;
+  }
+};
+
+Registry& registry() {
+  static Registry instance;
+  return instance;
+}
+
+ThreadStats::ThreadStats() {
+  Registry& reg = registry();
+  std::lock_guard lock(reg.mutex);
+  reg.threads.push_back(this);
+}
+
+ThreadStats::~ThreadStats() {
+  Registry& reg = registry();
+  std::lock_guard lock(reg.mutex);
+  StatValues values = load();
+  for (std::size_t i = 0; i < STAT_COUNT; ++i) {
+    reg.retired[i] += values[i];
+  }
+  std::erase(reg.threads, this);
+}
+
+KernelStats kernel_stats(const StatValues& values, Kernel kernel) {
+  auto first = static_cast<std::size_t>(kernel);
+  return {values[first], values[first + 1], values[first + 2]};
+}
+
+} // namespace
+
+void record_stat(Stat stat, std::uint64_t amount) {
+  thread_local ThreadStats stats;
+  std::atomic<std::uint64_t>& value = stats.values[static_cast<std::size_t>(stat)];
+  value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+BitSetStats bitset_stats() {
+  using detail::Kernel;
+  using detail::Stat;
+
+  detail::Registry& reg = detail::registry();
+  detail::StatValues values;
+  {
+    std::lock_guard lock(reg.mutex);
+    values = reg.total();
+    for (std::size_t i = 0; i < detail::STAT_COUNT; ++i) {
+      values[i] -= reg.baseline[i];
+    }
+  }
+
+  auto value = [&values](Stat stat) { return values[static_cast<std::size_t>(stat)]; };
+  BitSetStats result;
+  result.allocations = value(Stat::ALLOCATIONS);
+  result.deallocations = value(Stat::DEALLOCATIONS);
+  result.allocated_bytes = value(Stat::ALLOCATED_BYTES);
+  result.transform = detail::kernel_stats(values, Kernel::TRANSFORM);
+  result.scan = detail::kernel_stats(values, Kernel::SCAN);
+  result.compare = detail::kernel_stats(values, Kernel::COMPARE);
+  result.read = detail::kernel_stats(values, Kernel::READ);
+  result.reference_writes = value(Stat::REFERENCE_WRITES);
+  result.iterator_constructions = value(Stat::ITERATOR_CONSTRUCTIONS);
+  return result;
+}
+
+void reset_bitset_stats() {
+  detail::Registry& reg = detail::registry();
+  std::lock_guard lock(reg.mutex);
+  reg.baseline = reg.total();
+}
+
+} // namespace ct
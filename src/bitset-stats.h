@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Hot-path instrumentation, enabled with the `CT_BITSET_STATS` build option. When it is off, recording a statistic
+// compiles to nothing and `bitset_stats()` always returns zeros.
+#ifndef CT_BITSET_STATS
+#define CT_BITSET_STATS 0
+#endif
+
+namespace ct {
+
+// Words touched by a family of word-level kernels, split by how they were accessed
+struct KernelStats {
+  std::uint64_t aligned_words = 0;    // whole words read at a word boundary
+  std::uint64_t misaligned_words = 0; // whole words assembled from two storage words with a funnel shift
+  std::uint64_t partial_words = 0;    // first and last words of a range, processed under a mask
+
+  friend bool operator==(const KernelStats&, const KernelStats&) = default;
+};
+
+struct BitSetStats {
+  std::uint64_t allocations = 0;
+  std::uint64_t deallocations = 0;
+  std::uint64_t allocated_bytes = 0;
+
+  KernelStats transform; // `&=`, `|=`, `^=` and copies between ranges
+  KernelStats scan;      // `count`, `all`, `any`, `set`, `reset`, `flip`, index extraction
+  KernelStats compare;   // `==`, `<=>`
+  KernelStats read;      // sequential reads such as hashing and `to_string`
+
+  // Per-bit fallbacks
+  std::uint64_t reference_writes = 0;
+  std::uint64_t iterator_constructions = 0;
+
+  friend bool operator==(const BitSetStats&, const BitSetStats&) = default;
+};
+
+// Sum of the counters of all threads since the last `reset_bitset_stats()`
+BitSetStats bitset_stats();
+void reset_bitset_stats();
+
+namespace detail {
+
+inline constexpr bool STATS_ENABLED = CT_BITSET_STATS;
+
+enum class Stat : std::uint8_t {
+  ALLOCATIONS,
+  DEALLOCATIONS,
+  ALLOCATED_BYTES,
+  TRANSFORM_ALIGNED,
+  TRANSFORM_MISALIGNED,
+  TRANSFORM_PARTIAL,
+  SCAN_ALIGNED,
+  SCAN_MISALIGNED,
+  SCAN_PARTIAL,
+  COMPARE_ALIGNED,
+  COMPARE_MISALIGNED,
+  COMPARE_PARTIAL,
+  READ_ALIGNED,
+  READ_MISALIGNED,
+  READ_PARTIAL,
+  REFERENCE_WRITES,
+  ITERATOR_CONSTRUCTIONS,
+  COUNT,
+};
+
+// Kernel families, each owning three consecutive `Stat` entries: aligned, misaligned and partial words
+enum class Kernel : std::uint8_t {
+  TRANSFORM = static_cast<std::uint8_t>(Stat::TRANSFORM_ALIGNED),
+  SCAN = static_cast<std::uint8_t>(Stat::SCAN_ALIGNED),
+  COMPARE = static_cast<std::uint8_t>(Stat::COMPARE_ALIGNED),
+  READ = static_cast<std::uint8_t>(Stat::READ_ALIGNED),
+};
+
+// Adds `amount` to the calling thread's counter
+void record_stat(Stat stat, std::uint64_t amount);
+
+inline void record(Stat stat, std::uint64_t amount = 1) {
+  if constexpr (STATS_ENABLED) {
+    if (amount != 0) {
+      record_stat(stat, amount);
+    }
+  }
+}
+
+inline void record_words(Kernel kernel, std::uint64_t aligned, std::uint64_t misaligned, std::uint64_t partial) {
+  if constexpr (STATS_ENABLED) {
+    auto first = static_cast<std::uint8_t>(kernel);
+    record(static_cast<Stat>(first), aligned);
+    record(static_cast<Stat>(first + 1), misaligned);
+    record(static_cast<Stat>(first + 2), partial);
+  }
+}
+
+} // namespace detail
+
+} // namespace ct
@@ -0,0 +1,93 @@
+#include "bitset-stream.h"
+
+#include <span>
+
+namespace ct {
+
+BitWriter::BitWriter()
+    : _pending(0)
+    , _filled(0) {}
+
+void BitWriter::write_unary(std::size_t zeros) {
+  for (; zeros >= detail::WORD_BITS; zeros -= detail::WORD_BITS) {
+    write(0, detail::WORD_BITS);
+  }
+  write(1, zeros + 1);
+}
+
+void BitWriter::write(const BitSet::ConstView& bits) {
+  detail::for_each_chunk(bits.data(), bits.offset(), bits.size(), [&](Word chunk, std::size_t count) {
+    write(chunk >> (detail::WORD_BITS - count), count);
+  });
+}
+
+void BitWriter::reserve(std::size_t bits) {
+  _bits.reserve(bits);
+}
+
+BitSet BitWriter::to_bitset() const& {
+  BitSet result;
+  result.reserve(size() + detail::WORD_BITS);
+  result.append(_bits);
+  flush(result);
+  return result;
+}
+
+BitSet BitWriter::to_bitset() && {
+  flush(_bits);
+  _pending = 0;
+  _filled = 0;
+  BitSet result;
+  result.swap(_bits);
+  return result;
+}
+
+void BitWriter::clear() {
+  _bits.resize(0);
+  _pending = 0;
+  _filled = 0;
+}
+
+// The pending word is appended whole, and its unused low bits, which are zero, are cut off again
+void BitWriter::flush(BitSet& bits) const {
+  if (_filled != 0) {
+    bits.append_word(_pending);
+    bits.resize(bits.size() - detail::WORD_BITS + _filled);
+  }
+}
+
+BitReader::BitReader(const BitSet::ConstView& bits)
+    : _data(bits.data())
+    , _begin(bits.offset())
+    , _position(bits.offset())
+    , _end(bits.offset() + bits.size())
+    , _buffer(0)
+    , _buffered(0) {}
+
+void BitReader::skip(std::size_t count) {
+  if (count < _buffered) {
+    _buffer <<= count;
+    _buffered -= count;
+  } else {
+    _position += count - _buffered;
+    _buffer = 0;
+    _buffered = 0;
+  }
+}
+
+std::size_t BitReader::read_long_unary() {
+  std::size_t zeros = 0;
+  while (true) {
+    zeros += _buffered;
+    _buffered = 0;
+    refill();
+    if (_buffer != 0) {
+      return zeros + read_unary();
+    }
+    if (_buffered == 0) {
+      return zeros;
+    }
+  }
+}
+
+} // namespace ct
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "bitset.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+
+namespace ct {
+
+// Appends bits to a growing sequence. Bits are collected in a register word and appended a whole word at a time to a
+// `BitSet` with amortized growth, so writing a field costs a few shifts rather than a read-modify-write per bit.
+// Fields are written most significant bit first, which is also the order in which `BitReader` returns them.
+class BitWriter {
+public:
+  using Word = detail::Word;
+
+  BitWriter();
+
+  std::size_t size() const {
+    return _bits.size() + _filled;
+  }
+
+  // Appends the lowest `count` bits of `value` (`count <= WORD_BITS`); higher bits of `value` are ignored
+  void write(Word value, std::size_t count) {
+    if (count == 0) {
+      return;
+    }
+    value <<= detail::WORD_BITS - count;
+    _pending |= value >> _filled;
+    _filled += count;
+    if (_filled >= detail::WORD_BITS) {
+      _bits.append_word(_pending);
+      _filled -= detail::WORD_BITS;
+      _pending = (_filled == 0) ? 0 : value << (count - _filled);
+    }
+  }
+
+  void write_bit(bool bit) {
+    write(bit, 1);
+  }
+
+  // Appends `zeros` zero bits followed by a one
+  void write_unary(std::size_t zeros);
+
+  void write(const BitSet::ConstView& bits);
+
+  // Reserves storage for `bits` bits in total
+  void reserve(std::size_t bits);
+
+  // The bits written so far: a copy, or the bitset itself moved out of an rvalue writer, which is left empty
+  BitSet to_bitset() const&;
+  BitSet to_bitset() &&;
+
+  // Keeps the storage for reuse
+  void clear();
+
+private:
+  // Appends the bits still held in `_pending` to `bits`
+  void flush(BitSet& bits) const;
+
+private:
+  BitSet _bits;
+  Word _pending;
+  std::size_t _filled;
+};
+
+// Reads consecutive fields from a view, in the order `BitWriter` writes them. The view must outlive the reader. Bits
+// are taken from the view a word at a time into a register buffer, and fields are cut from the buffer with shifts.
+// Reading or skipping past the end is not checked; `peek` is the exception and pads the end of the view with zeros, so
+// that decoders can look ahead by a fixed number of bits.
+class BitReader {
+public:
+  using Word = detail::Word;
+
+  explicit BitReader(const BitSet::ConstView& bits);
+
+  std::size_t position() const {
+    return _position - _begin - _buffered;
+  }
+
+  std::size_t remaining() const {
+    return _end - _position + _buffered;
+  }
+
+  // The next `count` bits (`count <= WORD_BITS`) as an integer whose most significant bit comes first
+  Word peek(std::size_t count) {
+    if (_buffered < count) {
+      refill();
+    }
+    return (count == 0) ? 0 : _buffer >> (detail::WORD_BITS - count);
+  }
+
+  Word read(std::size_t count) {
+    Word result = peek(count);
+    _buffer = (count == detail::WORD_BITS) ? 0 : _buffer << count;
+    _buffered -= count;
+    return result;
+  }
+
+  bool read_bit() {
+    return read(1) != 0;
+  }
+
+  void skip(std::size_t count);
+
+  // Consumes zero bits up to and including the next one and returns their number. Zeros are counted a word at a time.
+  // Without a one before the end, the rest of the view is consumed and its length returned.
+  std::size_t read_unary() {
+    if (_buffer == 0) {
+      return read_long_unary();
+    }
+    auto zeros = static_cast<std::size_t>(std::countl_zero(_buffer));
+    _buffer = (_buffer << zeros) << 1;
+    _buffered -= zeros + 1;
+    return zeros;
+  }
+
+private:
+  // Tops the buffer up to a full word, or to the end of the view
+  void refill() {
+    std::size_t count = std::min(detail::WORD_BITS - _buffered, _end - _position);
+    if (count != 0) {
+      _buffer |= detail::load_bits(_data, _position, count) >> _buffered;
+      _buffered += count;
+      _position += count;
+    }
+  }
+
+  std::size_t read_long_unary();
+
+private:
+  const Word* _data;
+  std::size_t _begin;
+  std::size_t _position;
+  std::size_t _end;
+  // The next `_buffered` bits in the most significant bits, followed by zeros
+  Word _buffer;
+  std::size_t _buffered;
+};
+
+} // namespace ct
@@ -0,0 +1,245 @@
+#include "bitset-tracked.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+
+namespace ct {
+
+namespace {
+
+using detail::Word;
+
+constexpr std::size_t NUMBER_BYTES = sizeof(std::uint64_t);
+
+void put(std::vector<std::byte>& out, std::uint64_t value) {
+  for (std::size_t i = 0; i < NUMBER_BYTES; ++i) {
+    out.push_back(static_cast<std::byte>(value >> (8 * i)));
+  }
+}
+
+std::uint64_t get(const std::byte* in) {
+  std::uint64_t result = 0;
+  for (std::size_t i = 0; i < NUMBER_BYTES; ++i) {
+    result |= std::to_integer<std::uint64_t>(in[i]) << (8 * i);
+  }
+  return result;
+}
+
+std::size_t chunk_count(std::size_t size) {
+  return (size + TrackedBitSet::CHUNK_BITS - 1) / TrackedBitSet::CHUNK_BITS;
+}
+
+} // namespace
+
+TrackedBitSet::TrackedBitSet()
+    : TrackedBitSet(0, false) {}
+
+TrackedBitSet::TrackedBitSet(std::size_t size, bool value)
+    : _bits(size, value)
+    , _dirty(chunk_count(size), false) {}
+
+TrackedBitSet::TrackedBitSet(const ConstView& bits)
+    : _bits(bits)
+    , _dirty(chunk_count(bits.size()), false) {}
+
+std::size_t TrackedBitSet::size() const {
+  return _bits.size();
+}
+
+bool TrackedBitSet::empty() const {
+  return _bits.empty();
+}
+
+TrackedBitSet::Reference TrackedBitSet::operator[](std::size_t index) {
+  return {_bits[index], _dirty[index / CHUNK_BITS]};
+}
+
+TrackedBitSet::ConstReference TrackedBitSet::operator[](std::size_t index) const {
+  return _bits[index];
+}
+
+TrackedBitSet::View TrackedBitSet::mutable_view(std::size_t offset, std::size_t count) {
+  return View(_bits, _dirty, 0).subview(offset, count);
+}
+
+TrackedBitSet::ConstView TrackedBitSet::view() const {
+  return _bits;
+}
+
+TrackedBitSet::operator ConstView() const {
+  return _bits;
+}
+
+TrackedBitSet& TrackedBitSet::operator&=(const ConstView& other) & {
+  update(other, std::bit_and<>());
+  return *this;
+}
+
+TrackedBitSet& TrackedBitSet::operator|=(const ConstView& other) & {
+  update(other, std::bit_or<>());
+  return *this;
+}
+
+TrackedBitSet& TrackedBitSet::operator^=(const ConstView& other) & {
+  update(other, std::bit_xor<>());
+  return *this;
+}
+
+TrackedBitSet& TrackedBitSet::flip() & {
+  _bits.flip();
+  mark(0, size());
+  return *this;
+}
+
+TrackedBitSet& TrackedBitSet::set() & {
+  _bits.set();
+  mark(0, size());
+  return *this;
+}
+
+TrackedBitSet& TrackedBitSet::reset() & {
+  _bits.reset();
+  mark(0, size());
+  return *this;
+}
+
+TrackedBitSet& TrackedBitSet::set_bits(std::span<const std::size_t> indices) & {
+  mutable_view().set_bits(indices);
+  return *this;
+}
+
+TrackedBitSet& TrackedBitSet::reset_bits(std::span<const std::size_t> indices) & {
+  mutable_view().reset_bits(indices);
+  return *this;
+}
+
+TrackedBitSet& TrackedBitSet::flip_bits(std::span<const std::size_t> indices) & {
+  mutable_view().flip_bits(indices);
+  return *this;
+}
+
+const BitSet& TrackedBitSet::dirty() const {
+  return _dirty;
+}
+
+void TrackedBitSet::clear_dirty() {
+  _dirty.reset();
+}
+
+std::vector<std::byte> TrackedBitSet::export_delta() const {
+  std::vector<std::uint64_t> chunks;
+  _dirty.append_indices(chunks);
+  const Word* data = _bits.subview().data();
+  std::size_t words = detail::word_count(size());
+
+  std::vector<std::byte> result;
+  result.reserve(NUMBER_BYTES * (1 + chunks.size() * (CHUNK_WORDS + 2)));
+  put(result, size());
+  for (std::size_t i = 0; i < chunks.size();) {
+    std::size_t first = i;
+    for (++i; i < chunks.size() && chunks[i] == chunks[i - 1] + 1; ++i) {}
+    put(result, chunks[first]);
+    put(result, i - first);
+    std::size_t end = std::min((chunks[i - 1] + 1) * CHUNK_WORDS, words);
+    for (std::size_t word = chunks[first] * CHUNK_WORDS; word < end; ++word) {
+      put(result, data[word]);
+    }
+  }
+  return result;
+}
+
+// The delta is validated completely before anything is written
+bool TrackedBitSet::apply_delta(std::span<const std::byte> delta) {
+  if (delta.size() < NUMBER_BYTES || get(delta.data()) != size()) {
+    return false;
+  }
+  std::size_t words = detail::word_count(size());
+  std::size_t chunks = _dirty.size();
+  Word* data = BitSet::View(_bits).data();
+
+  auto parse = [&](bool write) {
+    for (std::size_t position = NUMBER_BYTES; position != delta.size();) {
+      if (delta.size() - position < 2 * NUMBER_BYTES) {
+        return false;
+      }
+      std::uint64_t first = get(delta.data() + position);
+      std::uint64_t count = get(delta.data() + position + NUMBER_BYTES);
+      position += 2 * NUMBER_BYTES;
+      if (count == 0 || first >= chunks || count > chunks - first) {
+        return false;
+      }
+      std::size_t begin = first * CHUNK_WORDS;
+      std::size_t end = std::min((first + count) * CHUNK_WORDS, words);
+      if ((delta.size() - position) / NUMBER_BYTES < end - begin) {
+        return false;
+      }
+      if (write) {
+        for (std::size_t word = begin; word < end; ++word, position += NUMBER_BYTES) {
+          data[word] = get(delta.data() + position);
+        }
+        _dirty.subview(first, count).set();
+      } else {
+        position += (end - begin) * NUMBER_BYTES;
+      }
+    }
+    return true;
+  };
+
+  if (!parse(false)) {
+    return false;
+  }
+  parse(true);
+  if (size() % detail::WORD_BITS != 0) {
+    data[words - 1] &= detail::range_mask(0, size() % detail::WORD_BITS);
+  }
+  return true;
+}
+
+void TrackedBitSet::mark(std::size_t offset, std::size_t count) {
+  if (count != 0) {
+    std::size_t first = offset / CHUNK_BITS;
+    _dirty.subview(first, (offset + count - 1) / CHUNK_BITS - first + 1).set();
+  }
+}
+
+// A single pass over the words. The changed bits of every chunk are collected on the way, and its dirty flag is set
+// without a branch.
+template <typename Op>
+void TrackedBitSet::update(const ConstView& other, Op op) {
+  Word* data = BitSet::View(_bits).data();
+  Word* dirty = BitSet::View(_dirty).data();
+  std::size_t full_words = size() / detail::WORD_BITS;
+  auto combine = [&](auto load) {
+    for (std::size_t first = 0; first < full_words; first += CHUNK_WORDS) {
+      std::size_t last = std::min(first + CHUNK_WORDS, full_words);
+      Word changed = 0;
+      for (std::size_t i = first; i < last; ++i) {
+        Word next = op(data[i], load(i));
+        changed |= next ^ data[i];
+        data[i] = next;
+      }
+      std::size_t chunk = first / CHUNK_WORDS;
+      dirty[chunk / detail::WORD_BITS] |= (changed != 0) ? detail::bit_mask(chunk % detail::WORD_BITS) : 0;
+    }
+  };
+  const Word* source = other.data();
+  std::size_t shift = other.offset();
+  if (shift == 0) {
+    combine([&](std::size_t i) { return source[i]; });
+  } else {
+    combine([&](std::size_t i) { return detail::funnel_load(source + i, shift); });
+  }
+
+  std::size_t rest = size() % detail::WORD_BITS;
+  if (rest != 0) {
+    Word value = detail::load_bits(source, shift + full_words * detail::WORD_BITS, rest);
+    Word next = op(data[full_words], value) & detail::range_mask(0, rest);
+    if (next != data[full_words]) {
+      _dirty[full_words / CHUNK_WORDS] = true;
+    }
+    data[full_words] = next;
+  }
+}
+
+} // namespace ct
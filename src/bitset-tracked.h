@@ -0,0 +1,236 @@
+#pragma once
+
+#include "bitset.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ct {
+
+// Bitset that records which chunks of `CHUNK_BITS` bits were modified since the last checkpoint, so that replicas can
+// be updated with the changed chunks only. Tracking lives in this wrapper: a plain `BitSet` pays nothing for it.
+//
+// Mutable access marks what it changes at the time of the write: a reference marks the chunk of its bit, batched writes
+// mark the chunks of their positions, and other modifying operations on a mutable view mark every chunk the view
+// covers. So a reference or a view kept across `clear_dirty` still records its later writes. Neither gives out raw
+// storage: views only convert to a `ConstView`, and iterate read-only. Bitwise operations of the set itself with
+// another view mark only the chunks whose contents actually changed.
+class TrackedBitSet {
+public:
+  using ConstReference = BitSet::ConstReference;
+  using ConstView = BitSet::ConstView;
+
+  static constexpr std::size_t NPOS = -1;
+  static constexpr std::size_t CHUNK_WORDS = 8;
+  static constexpr std::size_t CHUNK_BITS = CHUNK_WORDS * detail::WORD_BITS;
+
+  // Proxy for a bit, marking its chunk dirty on every write
+  class Reference {
+  public:
+    Reference() = delete;
+
+    operator bool() const {
+      return _bit;
+    }
+
+    const Reference& operator=(bool value) const {
+      _bit = value;
+      _flag = true;
+      return *this;
+    }
+
+    void flip() const {
+      _bit.flip();
+      _flag = true;
+    }
+
+  private:
+    Reference(BitSet::Reference bit, BitSet::Reference flag)
+        : _bit(bit)
+        , _flag(flag) {}
+
+  private:
+    BitSet::Reference _bit;
+    BitSet::Reference _flag;
+
+    friend class TrackedBitSet;
+  };
+
+  // Mutable view of a range of bits, marking every chunk it covers dirty after each modifying operation
+  class View {
+  public:
+    using ConstIterator = BitSet::ConstIterator;
+
+    std::size_t size() const {
+      return _bits.size();
+    }
+
+    bool empty() const {
+      return _bits.empty();
+    }
+
+    operator ConstView() const {
+      return _bits;
+    }
+
+    Reference operator[](std::size_t index) const {
+      return {_bits[index], _dirty[(_offset + index) / CHUNK_BITS]};
+    }
+
+    ConstIterator begin() const {
+      return ConstView(_bits).begin();
+    }
+
+    ConstIterator end() const {
+      return ConstView(_bits).end();
+    }
+
+    View subview(std::size_t offset = 0, std::size_t count = NPOS) const {
+      offset = std::min(offset, size());
+      return {_bits.subview(offset, count), _dirty, _offset + offset};
+    }
+
+    const View& set() const {
+      return write([](const BitSet::View& bits) { bits.set(); });
+    }
+
+    const View& reset() const {
+      return write([](const BitSet::View& bits) { bits.reset(); });
+    }
+
+    const View& flip() const {
+      return write([](const BitSet::View& bits) { bits.flip(); });
+    }
+
+    const View& operator&=(const ConstView& other) const {
+      return write([&](const BitSet::View& bits) { bits &= other; });
+    }
+
+    const View& operator|=(const ConstView& other) const {
+      return write([&](const BitSet::View& bits) { bits |= other; });
+    }
+
+    const View& operator^=(const ConstView& other) const {
+      return write([&](const BitSet::View& bits) { bits ^= other; });
+    }
+
+    const View& shift_left(std::size_t count) const {
+      return write([&](const BitSet::View& bits) { bits.shift_left(count); });
+    }
+
+    const View& shift_right(std::size_t count) const {
+      return write([&](const BitSet::View& bits) { bits.shift_right(count); });
+    }
+
+    const View& rotate_left(std::size_t count) const {
+      return write([&](const BitSet::View& bits) { bits.rotate_left(count); });
+    }
+
+    const View& rotate_right(std::size_t count) const {
+      return write([&](const BitSet::View& bits) { bits.rotate_right(count); });
+    }
+
+    const View& reverse() const {
+      return write([](const BitSet::View& bits) { bits.reverse(); });
+    }
+
+    // Batched writes mark only the chunks of the listed positions
+    const View& set_bits(std::span<const std::size_t> indices) const {
+      _bits.set_bits(indices);
+      return mark(indices);
+    }
+
+    const View& reset_bits(std::span<const std::size_t> indices) const {
+      _bits.reset_bits(indices);
+      return mark(indices);
+    }
+
+    const View& flip_bits(std::span<const std::size_t> indices) const {
+      _bits.flip_bits(indices);
+      return mark(indices);
+    }
+
+  private:
+    View(BitSet::View bits, BitSet::View dirty, std::size_t offset)
+        : _bits(bits)
+        , _dirty(dirty)
+        , _offset(offset) {}
+
+    template <typename Op>
+    const View& write(Op op) const {
+      op(_bits);
+      if (!_bits.empty()) {
+        std::size_t first = _offset / CHUNK_BITS;
+        _dirty.subview(first, (_offset + size() - 1) / CHUNK_BITS - first + 1).set();
+      }
+      return *this;
+    }
+
+    const View& mark(std::span<const std::size_t> indices) const {
+      for (std::size_t index : indices) {
+        _dirty[(_offset + index) / CHUNK_BITS] = true;
+      }
+      return *this;
+    }
+
+  private:
+    BitSet::View _bits;
+    // Flags of the whole set, and the position of the first bit of the view in it
+    BitSet::View _dirty;
+    std::size_t _offset;
+
+    friend class TrackedBitSet;
+  };
+
+  TrackedBitSet();
+  TrackedBitSet(std::size_t size, bool value);
+  explicit TrackedBitSet(const ConstView& bits);
+
+  std::size_t size() const;
+  bool empty() const;
+
+  Reference operator[](std::size_t index);
+  ConstReference operator[](std::size_t index) const;
+
+  View mutable_view(std::size_t offset = 0, std::size_t count = NPOS);
+  ConstView view() const;
+  operator ConstView() const;
+
+  TrackedBitSet& operator&=(const ConstView& other) &;
+  TrackedBitSet& operator|=(const ConstView& other) &;
+  TrackedBitSet& operator^=(const ConstView& other) &;
+  TrackedBitSet& flip() &;
+  TrackedBitSet& set() &;
+  TrackedBitSet& reset() &;
+  // Batched writes, marking only the chunks of the listed positions
+  TrackedBitSet& set_bits(std::span<const std::size_t> indices) &;
+  TrackedBitSet& reset_bits(std::span<const std::size_t> indices) &;
+  TrackedBitSet& flip_bits(std::span<const std::size_t> indices) &;
+
+  // One bit per chunk, set for the chunks modified since the last `clear_dirty`
+  const BitSet& dirty() const;
+  void clear_dirty();
+
+  // Encodes the dirty chunks: the size in bits, followed by runs of consecutive dirty chunks, each one being the index
+  // of its first chunk, the number of chunks and their words. Every number is stored as 8 little-endian bytes, so the
+  // encoding does not depend on the machine.
+  std::vector<std::byte> export_delta() const;
+
+  // Overwrites the chunks present in a delta of a bitset of the same size and marks them dirty. A malformed delta or
+  // one of a different size is rejected as a whole, and `false` is returned.
+  bool apply_delta(std::span<const std::byte> delta);
+
+private:
+  void mark(std::size_t offset, std::size_t count);
+
+  template <typename Op>
+  void update(const ConstView& other, Op op);
+
+private:
+  BitSet _bits;
+  BitSet _dirty;
+};
+
+} // namespace ct
@@ -0,0 +1,203 @@
+#include "bitset-view.h"
+
+#include <functional>
+
+namespace ct {
+
+template <typename W>
+bool BitView<W>::all() const {
+  return detail::all(_data, _offset, _size);
+}
+
+template <typename W>
+bool BitView<W>::any() const {
+  return detail::any(_data, _offset, _size);
+}
+
+template <typename W>
+std::size_t BitView<W>::count() const {
+  return detail::count(_data, _offset, _size);
+}
+
+template <typename W>
+const BitView<W>& BitView<W>::set() const
+  requires (!std::is_const_v<W>)
+{
+  detail::fill(_data, _offset, _size, true);
+  return *this;
+}
+
+template <typename W>
+const BitView<W>& BitView<W>::reset() const
+  requires (!std::is_const_v<W>)
+{
+  detail::fill(_data, _offset, _size, false);
+  return *this;
+}
+
+template <typename W>
+const BitView<W>& BitView<W>::flip() const
+  requires (!std::is_const_v<W>)
+{
+  detail::flip(_data, _offset, _size);
+  return *this;
+}
+
+template <typename W>
+const BitView<W>& BitView<W>::operator&=(const ConstView& other) const
+  requires (!std::is_const_v<W>)
+{
+  detail::transform(_data, _offset, other._data, other._offset, _size, std::bit_and<>());
+  return *this;
+}
+
+template <typename W>
+const BitView<W>& BitView<W>::operator|=(const ConstView& other) const
+  requires (!std::is_const_v<W>)
+{
+  detail::transform(_data, _offset, other._data, other._offset, _size, std::bit_or<>());
+  return *this;
+}
+
+template <typename W>
+const BitView<W>& BitView<W>::operator^=(const ConstView& other) const
+  requires (!std::is_const_v<W>)
+{
+  detail::transform(_data, _offset, other._data, other._offset, _size, std::bit_xor<>());
+  return *this;
+}
+
+template <typename W>
+const BitView<W>& BitView<W>::shift_left(std::size_t count) const
+  requires (!std::is_const_v<W>)
+{
+  detail::shift_left(_data, _offset, _size, count);
+  return *this;
+}
+
+template <typename W>
+const BitView<W>& BitView<W>::shift_right(std::size_t count) const
+  requires (!std::is_const_v<W>)
+{
+  detail::shift_right(_data, _offset, _size, count);
+  return *this;
+}
+
+template <typename W>
+const BitView<W>& BitView<W>::rotate_left(std::size_t count) const
+  requires (!std::is_const_v<W>)
+{
+  detail::rotate_left(_data, _offset, _size, count);
+  return *this;
+}
+
+template <typename W>
+const BitView<W>& BitView<W>::rotate_right(std::size_t count) const
+  requires (!std::is_const_v<W>)
+{
+  detail::rotate_right(_data, _offset, _size, count);
+  return *this;
+}
+
+template <typename W>
+const BitView<W>& BitView<W>::reverse() const
+  requires (!std::is_const_v<W>)
+{
+  detail::reverse(_data, _offset, _size);
+  return *this;
+}
+
+template <typename W>
+const BitView<W>& BitView<W>::set_bits(std::span<const std::size_t> indices) const
+  requires (!std::is_const_v<W>)
+{
+  detail::update_bits(_data, _offset, _size, indices, detail::BitUpdate::SET);
+  return *this;
+}
+
+template <typename W>
+const BitView<W>& BitView<W>::reset_bits(std::span<const std::size_t> indices) const
+  requires (!std::is_const_v<W>)
+{
+  detail::update_bits(_data, _offset, _size, indices, detail::BitUpdate::RESET);
+  return *this;
+}
+
+template <typename W>
+const BitView<W>& BitView<W>::flip_bits(std::span<const std::size_t> indices) const
+  requires (!std::is_const_v<W>)
+{
+  detail::update_bits(_data, _offset, _size, indices, detail::BitUpdate::FLIP);
+  return *this;
+}
+
+template <typename W>
+void BitView<W>::test_bits(std::span<const std::size_t> indices, std::span<bool> out) const {
+  detail::test_bits(_data, _offset, indices, out);
+}
+
+template <typename W>
+void BitView<W>::test_bits(std::span<const std::size_t> indices, const BitView<Word>& out) const {
+  detail::test_bits(_data, _offset, indices, out._data, out._offset);
+}
+
+template <typename W>
+std::size_t BitView<W>::to_indices(std::span<std::uint32_t> out) const {
+  return detail::extract_indices(_data, _offset, _size, out);
+}
+
+template <typename W>
+std::size_t BitView<W>::to_indices(std::span<std::uint64_t> out) const {
+  return detail::extract_indices(_data, _offset, _size, out);
+}
+
+template <typename W>
+void BitView<W>::append_indices(std::vector<std::uint32_t>& out) const {
+  std::size_t old_size = out.size();
+  out.resize(old_size + count());
+  to_indices(std::span(out).subspan(old_size));
+}
+
+template <typename W>
+void BitView<W>::append_indices(std::vector<std::uint64_t>& out) const {
+  std::size_t old_size = out.size();
+  out.resize(old_size + count());
+  to_indices(std::span(out).subspan(old_size));
+}
+
+template <typename W>
+const BitView<W>& BitView<W>::assign_indices(std::span<const std::uint32_t> indices) const
+  requires (!std::is_const_v<W>)
+{
+  detail::assign_indices(_data, _offset, _size, indices);
+  return *this;
+}
+
+template <typename W>
+const BitView<W>& BitView<W>::assign_indices(std::span<const std::uint64_t> indices) const
+  requires (!std::is_const_v<W>)
+{
+  detail::assign_indices(_data, _offset, _size, indices);
+  return *this;
+}
+
+template <typename W>
+RunRange BitView<W>::runs() const {
+  return RunRange(_data, _offset, _size, true);
+}
+
+template <typename W>
+RunRange BitView<W>::zero_runs() const {
+  return RunRange(_data, _offset, _size, false);
+}
+
+template <typename W>
+std::size_t BitView<W>::find_run(std::size_t min_length, bool value) const {
+  std::size_t start = detail::find_run(_data, _offset, _size, min_length, value);
+  return (start == _size && min_length != 0) ? NPOS : start;
+}
+
+template class BitView<detail::Word>;
+template class BitView<const detail::Word>;
+
+} // namespace ct
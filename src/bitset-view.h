@@ -1,7 +1,218 @@
 #pragma once
 
+#include "bitset-batch.h"
+#include "bitset-indices.h"
+#include "bitset-iterator.h"
+#include "bitset-layout.h"
+#include "bitset-reference.h"
+#include "bitset-reverse.h"
+#include "bitset-runs.h"
+#include "bitset-shift.h"
+#include "bitset-words.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace ct {
 
-// TODO BitSet views
+// Non-owning view of a contiguous range of bits. `W` is either `Word` or `const Word`, the latter giving a read-only
+// view. Views behave like pointers: copying is shallow, and modifying operations are `const` since they change the
+// referenced bits rather than the view itself.
+template <typename W>
+class BitView {
+public:
+  using Value = bool;
+  using Word = std::remove_const_t<W>;
+  using Reference = BitReference<W>;
+  using ConstReference = BitReference<const Word>;
+  using Iterator = BitIterator<W>;
+  using ConstIterator = BitIterator<const Word>;
+  using View = BitView<W>;
+  using ConstView = BitView<const Word>;
+  using Byte = std::conditional_t<std::is_const_v<W>, const std::byte, std::byte>;
+
+  static constexpr std::size_t NPOS = -1;
+
+  BitView() = default;
+
+  BitView(Iterator first, Iterator last)
+      : _data(first._word)
+      , _offset(first._offset)
+      , _size(static_cast<std::size_t>(last - first)) {}
+
+  // View of `size` bits starting at bit `offset` of caller-provided words in the native layout. Nothing is copied:
+  // the words must outlive the view, and all operations work on them directly.
+  explicit BitView(std::span<W> words, std::size_t offset = 0, std::size_t size = NPOS)
+      : BitView(BitView(words.data(), 0, words.size() * detail::WORD_BITS).subview(offset, size)) {}
+
+  // Same over raw bytes, for example a network or shared memory buffer, stored with the given byte order and bit
+  // order. The layout must be the native one (see `is_native_layout`); other layouts can be converted in place with
+  // `convert_layout` first. The bytes must be aligned for `Word`, and their number must be a multiple of its size.
+  // Throws `std::invalid_argument` otherwise.
+  BitView(
+      std::span<Byte> bytes, std::endian byte_order, BitOrder bit_order, std::size_t offset = 0, std::size_t size = NPOS
+  )
+      : BitView(native_words(bytes, byte_order, bit_order), offset, size) {}
+
+  template <typename U>
+  BitView(const BitView<U>& other)
+    requires (std::is_const_v<W> && !std::is_const_v<U>)
+      : _data(other._data)
+      , _offset(other._offset)
+      , _size(other._size) {}
+
+  void swap(BitView& other) {
+    std::swap(_data, other._data);
+    std::swap(_offset, other._offset);
+    std::swap(_size, other._size);
+  }
+
+  friend void swap(BitView& lhs, BitView& rhs) {
+    lhs.swap(rhs);
+  }
+
+  std::size_t size() const {
+    return _size;
+  }
+
+  bool empty() const {
+    return _size == 0;
+  }
+
+  Reference operator[](std::size_t index) const {
+    return *(begin() + static_cast<std::ptrdiff_t>(index));
+  }
+
+  Iterator begin() const {
+    return Iterator(_data, _offset);
+  }
+
+  Iterator end() const {
+    return Iterator(_data, _offset + _size);
+  }
+
+  // Pointer to the storage word holding the first bit of the view
+  W* data() const {
+    return _data;
+  }
+
+  // Position of the first bit of the view inside `*data()`, always less than the word width
+  std::size_t offset() const {
+    return _offset;
+  }
+
+  bool all() const;
+  bool any() const;
+  std::size_t count() const;
+
+  const BitView& set() const
+    requires (!std::is_const_v<W>);
+  const BitView& reset() const
+    requires (!std::is_const_v<W>);
+  const BitView& flip() const
+    requires (!std::is_const_v<W>);
+
+  const BitView& operator&=(const ConstView& other) const
+    requires (!std::is_const_v<W>);
+  const BitView& operator|=(const ConstView& other) const
+    requires (!std::is_const_v<W>);
+  const BitView& operator^=(const ConstView& other) const
+    requires (!std::is_const_v<W>);
+
+  // Size-preserving shifts and rotations in place. Shifting left by `count` moves the bit at `i + count` to `i` and
+  // zero-fills the last `count` bits; bits outside of the view are not affected.
+  const BitView& shift_left(std::size_t count) const
+    requires (!std::is_const_v<W>);
+  const BitView& shift_right(std::size_t count) const
+    requires (!std::is_const_v<W>);
+  const BitView& rotate_left(std::size_t count) const
+    requires (!std::is_const_v<W>);
+  const BitView& rotate_right(std::size_t count) const
+    requires (!std::is_const_v<W>);
+
+  // Reverses the order of the bits of the view in place, so that the first bit becomes the last one
+  const BitView& reverse() const
+    requires (!std::is_const_v<W>);
+
+  // Batched access to many random positions. Updates to the same word are merged and storage is prefetched ahead,
+  // so that independent cache misses overlap; set/reset/flip may additionally reorder the positions for locality.
+  const BitView& set_bits(std::span<const std::size_t> indices) const
+    requires (!std::is_const_v<W>);
+  const BitView& reset_bits(std::span<const std::size_t> indices) const
+    requires (!std::is_const_v<W>);
+  const BitView& flip_bits(std::span<const std::size_t> indices) const
+    requires (!std::is_const_v<W>);
+
+  // Stores the bit at `indices[i]` into `out[i]`
+  void test_bits(std::span<const std::size_t> indices, std::span<bool> out) const;
+  void test_bits(std::span<const std::size_t> indices, const BitView<Word>& out) const;
+
+  // Positions of set bits in ascending order. `to_indices` fills at most `out.size()` positions and returns their
+  // number; `append_indices` adds all of them to the end of `out`. Positions must be representable in the element type.
+  std::size_t to_indices(std::span<std::uint32_t> out) const;
+  std::size_t to_indices(std::span<std::uint64_t> out) const;
+  void append_indices(std::vector<std::uint32_t>& out) const;
+  void append_indices(std::vector<std::uint64_t>& out) const;
+
+  // Makes the listed positions (preferably sorted) the only set bits of the view
+  const BitView& assign_indices(std::span<const std::uint32_t> indices) const
+    requires (!std::is_const_v<W>);
+  const BitView& assign_indices(std::span<const std::uint64_t> indices) const
+    requires (!std::is_const_v<W>);
+
+  // Maximal runs of set bits, or of clear bits, in ascending order
+  RunRange runs() const;
+  RunRange zero_runs() const;
+
+  // Start of the first run of at least `min_length` bits equal to `value`, or `NPOS` if there is none. An empty run is
+  // found at 0, even in an empty range. Runs shorter than a word are found with shifts inside the word, so this takes
+  // time proportional to the number of words.
+  std::size_t find_run(std::size_t min_length, bool value = false) const;
+
+  BitView subview(std::size_t offset = 0, std::size_t count = NPOS) const {
+    offset = std::min(offset, _size);
+    return BitView(_data, _offset + offset, std::min(count, _size - offset));
+  }
+
+private:
+  static std::span<W> native_words(std::span<Byte> bytes, std::endian byte_order, BitOrder bit_order) {
+    if (!is_native_layout(byte_order, bit_order)) {
+      throw std::invalid_argument("bytes are not in the native layout");
+    }
+    if (bytes.size() % sizeof(Word) != 0 || reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(Word) != 0) {
+      throw std::invalid_argument("bytes are not whole aligned words");
+    }
+    return {reinterpret_cast<W*>(bytes.data()), bytes.size() / sizeof(Word)};
+  }
+
+  BitView(W* data, std::size_t offset, std::size_t size)
+      : _data(data + offset / detail::WORD_BITS)
+      , _offset(offset % detail::WORD_BITS)
+      , _size(size) {}
+
+private:
+  W* _data = nullptr;
+  std::size_t _offset = 0;
+  std::size_t _size = 0;
+
+  friend class BitSet;
+  friend class BitMatrix;
+
+  template <typename>
+  friend class BitView;
+
+  template <typename>
+  friend class AlignedBitView;
+};
+
+extern template class BitView<detail::Word>;
+extern template class BitView<const detail::Word>;
 
 } // namespace ct
@@ -0,0 +1,178 @@
+#include "bitset-words.h"
+
+#include <bit>
+#include <cstring>
+
+namespace ct::detail {
+
+namespace {
+
+// Constants and folded 64x64->128 multiplication from wyhash
+constexpr Word HASH_SECRET[] = {0xa076'1d64'78bd'642f, 0xe703'7ed1'a0b4'28db, 0x8ebc'6af0'9c88'c6e3};
+
+Word mix(Word lhs, Word rhs) {
+#ifdef __SIZEOF_INT128__
+  __extension__ using Wide = unsigned __int128;
+  Wide product = static_cast<Wide>(lhs) * rhs;
+  return static_cast<Word>(product) ^ static_cast<Word>(product >> WORD_BITS);
+#else
+  Word lhs_high = lhs >> 32;
+  Word lhs_low = lhs & 0xffff'ffff;
+  Word rhs_high = rhs >> 32;
+  Word rhs_low = rhs & 0xffff'ffff;
+  Word low_low = lhs_low * rhs_low;
+  Word high_low = lhs_high * rhs_low;
+  Word low_high = lhs_low * rhs_high;
+  Word cross = (low_low >> 32) + (high_low & 0xffff'ffff) + low_high;
+  Word high = lhs_high * rhs_high + (high_low >> 32) + (cross >> 32);
+  Word low = (cross << 32) | (low_low & 0xffff'ffff);
+  return low ^ high;
+#endif
+}
+
+} // namespace
+
+std::size_t count(const Word* data, std::size_t offset, std::size_t size) {
+  std::size_t result = 0;
+  for_each_segment(data, offset, size, [&result](Word word, Word mask) {
+    result += std::popcount(word & mask);
+    return true;
+  });
+  return result;
+}
+
+bool all(const Word* data, std::size_t offset, std::size_t size) {
+  return for_each_segment(data, offset, size, [](Word word, Word mask) { return (word & mask) == mask; });
+}
+
+bool any(const Word* data, std::size_t offset, std::size_t size) {
+  return !for_each_segment(data, offset, size, [](Word word, Word mask) { return (word & mask) == 0; });
+}
+
+void fill(Word* data, std::size_t offset, std::size_t size, bool value) {
+  for_each_segment(data, offset, size, [value](Word& word, Word mask) {
+    word = value ? (word | mask) : (word & ~mask);
+    return true;
+  });
+}
+
+void flip(Word* data, std::size_t offset, std::size_t size) {
+  for_each_segment(data, offset, size, [](Word& word, Word mask) {
+    word ^= mask;
+    return true;
+  });
+}
+
+std::size_t mismatch(
+    const Word* lhs,
+    std::size_t lhs_offset,
+    const Word* rhs,
+    std::size_t rhs_offset,
+    std::size_t size
+) {
+  auto first_difference = [](Word lhs_bits, Word rhs_bits) {
+    return static_cast<std::size_t>(std::countl_zero(lhs_bits ^ rhs_bits));
+  };
+
+  std::size_t position = 0;
+  std::size_t lhs_shift = lhs_offset % WORD_BITS;
+  if (lhs_shift != 0 && size != 0) {
+    record_words(Kernel::COMPARE, 0, 0, 1);
+    std::size_t count = std::min(WORD_BITS - lhs_shift, size);
+    Word lhs_bits = load_bits(lhs, lhs_offset, count);
+    Word rhs_bits = load_bits(rhs, rhs_offset, count);
+    if (lhs_bits != rhs_bits) {
+      return first_difference(lhs_bits, rhs_bits);
+    }
+    position = count;
+  }
+
+  // From here on `lhs` is word-aligned, `rhs` is read with a funnel shift unless it happens to be aligned as well
+  std::size_t full_words = (size - position) / WORD_BITS;
+  const Word* lhs_word = lhs + (lhs_offset + position) / WORD_BITS;
+  const Word* rhs_word = rhs + (rhs_offset + position) / WORD_BITS;
+  std::size_t rhs_shift = (rhs_offset + position) % WORD_BITS;
+  if (rhs_shift == 0) {
+    for (std::size_t i = 0; i < full_words; ++i) {
+      if (lhs_word[i] != rhs_word[i]) {
+        record_words(Kernel::COMPARE, i + 1, 0, 0);
+        return position + i * WORD_BITS + first_difference(lhs_word[i], rhs_word[i]);
+      }
+    }
+    record_words(Kernel::COMPARE, full_words, 0, 0);
+  } else {
+    for (std::size_t i = 0; i < full_words; ++i) {
+      Word rhs_bits = funnel_load(rhs_word + i, rhs_shift);
+      if (lhs_word[i] != rhs_bits) {
+        record_words(Kernel::COMPARE, 0, i + 1, 0);
+        return position + i * WORD_BITS + first_difference(lhs_word[i], rhs_bits);
+      }
+    }
+    record_words(Kernel::COMPARE, 0, full_words, 0);
+  }
+  position += full_words * WORD_BITS;
+
+  if (position < size) {
+    record_words(Kernel::COMPARE, 0, 0, 1);
+    std::size_t count = size - position;
+    Word lhs_bits = load_bits(lhs, lhs_offset + position, count);
+    Word rhs_bits = load_bits(rhs, rhs_offset + position, count);
+    if (lhs_bits != rhs_bits) {
+      return position + first_difference(lhs_bits, rhs_bits);
+    }
+  }
+  return size;
+}
+
+std::size_t hash(const Word* data, std::size_t offset, std::size_t size) {
+  Word state = HASH_SECRET[0];
+  Word pending = 0;
+  bool has_pending = false;
+  for_each_chunk(data, offset, size, [&](Word chunk, std::size_t) {
+    if (has_pending) {
+      state = mix(pending ^ HASH_SECRET[1], chunk ^ state);
+    } else {
+      pending = chunk;
+    }
+    has_pending = !has_pending;
+  });
+  if (has_pending) {
+    state = mix(pending ^ HASH_SECRET[1], state);
+  }
+  return static_cast<std::size_t>(mix(state ^ HASH_SECRET[2], size ^ HASH_SECRET[1]));
+}
+
+bool equal(const Word* lhs, std::size_t lhs_offset, const Word* rhs, std::size_t rhs_offset, std::size_t size) {
+  if (lhs_offset % WORD_BITS != 0 || rhs_offset % WORD_BITS != 0) {
+    return mismatch(lhs, lhs_offset, rhs, rhs_offset, size) == size;
+  }
+
+  const Word* lhs_word = lhs + lhs_offset / WORD_BITS;
+  const Word* rhs_word = rhs + rhs_offset / WORD_BITS;
+  std::size_t full_words = size / WORD_BITS;
+  std::size_t rest = size % WORD_BITS;
+  record_words(Kernel::COMPARE, full_words, 0, rest != 0);
+  if (full_words != 0 && std::memcmp(lhs_word, rhs_word, full_words * sizeof(Word)) != 0) {
+    return false;
+  }
+  return rest == 0 || ((lhs_word[full_words] ^ rhs_word[full_words]) & range_mask(0, rest)) == 0;
+}
+
+std::strong_ordering compare(
+    const Word* lhs,
+    std::size_t lhs_offset,
+    std::size_t lhs_size,
+    const Word* rhs,
+    std::size_t rhs_offset,
+    std::size_t rhs_size
+) {
+  std::size_t common = std::min(lhs_size, rhs_size);
+  std::size_t position = mismatch(lhs, lhs_offset, rhs, rhs_offset, common);
+  if (position == common) {
+    return lhs_size <=> rhs_size;
+  }
+  Word lhs_bit = load_bits(lhs, lhs_offset + position, 1);
+  return (lhs_bit != 0) ? std::strong_ordering::greater : std::strong_ordering::less;
+}
+
+} // namespace ct::detail
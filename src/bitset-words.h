@@ -0,0 +1,206 @@
+#pragma once
+
+#include "bitset-stats.h"
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// Word-level kernels shared by `BitSet` and its views. A range of bits is described by a pointer to storage words,
+// a bit offset from that pointer and a bit count. Bits are stored MSB-first: the bit with offset 0 is the most
+// significant bit of its word, so comparing words as integers compares them lexicographically.
+namespace ct::detail {
+
+using Word = std::uint64_t;
+
+inline constexpr std::size_t WORD_BITS = std::numeric_limits<Word>::digits;
+inline constexpr Word ALL_ONES = ~Word(0);
+
+constexpr std::size_t word_count(std::size_t bits) {
+  return (bits + WORD_BITS - 1) / WORD_BITS;
+}
+
+constexpr Word bit_mask(std::size_t offset) {
+  return Word(1) << (WORD_BITS - 1 - offset);
+}
+
+// Bits with offsets in `[from, to)`, where `from < to <= WORD_BITS`
+constexpr Word range_mask(std::size_t from, std::size_t to) {
+  Word low = (to == WORD_BITS) ? 0 : (ALL_ONES >> to);
+  return (ALL_ONES >> from) & ~low;
+}
+
+// Returns `count` bits (`0 < count <= WORD_BITS`) starting at `position`, placed in the most significant bits
+inline Word load_bits(const Word* data, std::size_t position, std::size_t count) {
+  const Word* word = data + position / WORD_BITS;
+  std::size_t shift = position % WORD_BITS;
+  Word result = word[0] << shift;
+  if (shift != 0 && shift + count > WORD_BITS) {
+    result |= word[1] >> (WORD_BITS - shift);
+  }
+  return result & range_mask(0, count);
+}
+
+// Overwrites `count` bits (`0 < count <= WORD_BITS`) starting at `position` with the most significant bits of `value`
+inline void store_bits(Word* data, std::size_t position, std::size_t count, Word value) {
+  Word* word = data + position / WORD_BITS;
+  std::size_t shift = position % WORD_BITS;
+  Word mask = range_mask(0, count);
+  value &= mask;
+  word[0] = (word[0] & ~(mask >> shift)) | (value >> shift);
+  if (shift != 0 && shift + count > WORD_BITS) {
+    word[1] = (word[1] & ~(mask << (WORD_BITS - shift))) | (value << (WORD_BITS - shift));
+  }
+}
+
+inline void prefetch(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address);
+#else
+  static_cast<void>(address);
+#endif
+}
+
+// Returns the full word starting at bit `shift` of `word[0]`; both `word[0]` and `word[1]` must hold requested bits
+inline Word funnel_load(const Word* word, std::size_t shift) {
+  return (shift == 0) ? word[0] : (word[0] << shift) | (word[1] >> (WORD_BITS - shift));
+}
+
+// Calls `visit(word, mask)` for every storage word overlapping `[offset, offset + size)`, where `mask` selects the
+// bits of `word` that belong to the range. Stops early and returns `false` as soon as `visit` returns `false`.
+template <typename W, typename F>
+bool for_each_segment(W* data, std::size_t offset, std::size_t size, F visit) {
+  if (size == 0) {
+    return true;
+  }
+  W* word = data + offset / WORD_BITS;
+  std::size_t shift = offset % WORD_BITS;
+  if (shift + size <= WORD_BITS) {
+    record_words(Kernel::SCAN, 0, 0, 1);
+    return visit(*word, range_mask(shift, shift + size));
+  }
+  std::uint64_t full_words = 0;
+  std::uint64_t partial_words = 0;
+  auto finish = [&](bool completed) {
+    record_words(Kernel::SCAN, full_words, 0, partial_words);
+    return completed;
+  };
+  if (shift != 0) {
+    ++partial_words;
+    if (!visit(*word, range_mask(shift, WORD_BITS))) {
+      return finish(false);
+    }
+    ++word;
+    size -= WORD_BITS - shift;
+  }
+  for (; size >= WORD_BITS; size -= WORD_BITS, ++word) {
+    ++full_words;
+    if (!visit(*word, ALL_ONES)) {
+      return finish(false);
+    }
+  }
+  if (size != 0) {
+    ++partial_words;
+    return finish(visit(*word, range_mask(0, size)));
+  }
+  return finish(true);
+}
+
+// Calls `visit(chunk, count)` for consecutive chunks of the range, each holding `count` (at most WORD_BITS) bits in
+// its most significant bits and zeros in the rest. Chunks follow the logical bit order, regardless of `offset`.
+template <typename F>
+void for_each_chunk(const Word* data, std::size_t offset, std::size_t size, F visit) {
+  data += offset / WORD_BITS;
+  std::size_t shift = offset % WORD_BITS;
+  std::size_t full_words = size / WORD_BITS;
+  if (shift == 0) {
+    for (std::size_t i = 0; i < full_words; ++i) {
+      visit(data[i], WORD_BITS);
+    }
+  } else {
+    for (std::size_t i = 0; i < full_words; ++i) {
+      visit(funnel_load(data + i, shift), WORD_BITS);
+    }
+  }
+  std::size_t rest = size % WORD_BITS;
+  if (rest != 0) {
+    visit(load_bits(data, shift + full_words * WORD_BITS, rest), rest);
+  }
+  record_words(Kernel::READ, (shift == 0) ? full_words : 0, (shift == 0) ? 0 : full_words, rest != 0);
+}
+
+// Replaces every bit `d` of the destination range with `op(d, s)`, where `s` is the matching source bit.
+// The ranges must either coincide, not overlap at all, or the destination must start before the source.
+template <typename Op>
+void transform(Word* dst, std::size_t dst_offset, const Word* src, std::size_t src_offset, std::size_t size, Op op) {
+  if (size == 0) {
+    return;
+  }
+  dst += dst_offset / WORD_BITS;
+  dst_offset %= WORD_BITS;
+  std::size_t position = 0;
+  if (dst_offset != 0 || size < WORD_BITS) {
+    std::size_t count = std::min(WORD_BITS - dst_offset, size);
+    Word mask = range_mask(dst_offset, dst_offset + count);
+    Word value = load_bits(src, src_offset, count) >> dst_offset;
+    *dst = (*dst & ~mask) | (op(*dst, value) & mask);
+    ++dst;
+    position = count;
+  }
+
+  std::size_t full_words = (size - position) / WORD_BITS;
+  std::size_t src_position = src_offset + position;
+  const Word* src_word = src + src_position / WORD_BITS;
+  std::size_t shift = src_position % WORD_BITS;
+  if (shift == 0) {
+    for (std::size_t i = 0; i < full_words; ++i) {
+      dst[i] = op(dst[i], src_word[i]);
+    }
+  } else {
+    for (std::size_t i = 0; i < full_words; ++i) {
+      dst[i] = op(dst[i], funnel_load(src_word + i, shift));
+    }
+  }
+  dst += full_words;
+  std::uint64_t partial_words = (position != 0);
+  position += full_words * WORD_BITS;
+
+  if (position < size) {
+    std::size_t count = size - position;
+    Word mask = range_mask(0, count);
+    Word value = load_bits(src, src_offset + position, count);
+    *dst = (*dst & ~mask) | (op(*dst, value) & mask);
+    ++partial_words;
+  }
+  record_words(Kernel::TRANSFORM, (shift == 0) ? full_words : 0, (shift == 0) ? 0 : full_words, partial_words);
+}
+
+std::size_t count(const Word* data, std::size_t offset, std::size_t size);
+bool all(const Word* data, std::size_t offset, std::size_t size);
+bool any(const Word* data, std::size_t offset, std::size_t size);
+
+void fill(Word* data, std::size_t offset, std::size_t size, bool value);
+void flip(Word* data, std::size_t offset, std::size_t size);
+
+// Position of the first bit where the two ranges differ, or `size` if they are equal
+std::size_t mismatch(const Word* lhs, std::size_t lhs_offset, const Word* rhs, std::size_t rhs_offset, std::size_t size);
+
+bool equal(const Word* lhs, std::size_t lhs_offset, const Word* rhs, std::size_t rhs_offset, std::size_t size);
+
+// Lexicographic comparison of two ranges, a proper prefix ordered before the longer range
+std::strong_ordering compare(
+    const Word* lhs,
+    std::size_t lhs_offset,
+    std::size_t lhs_size,
+    const Word* rhs,
+    std::size_t rhs_offset,
+    std::size_t rhs_size
+);
+
+// Hash of the logical contents of the range, independent of where it starts in storage
+std::size_t hash(const Word* data, std::size_t offset, std::size_t size);
+
+} // namespace ct::detail
@@ -1,7 +1,685 @@
 #include "bitset.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <ostream>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 namespace ct {
 
-// TODO implement BitSet
+namespace {
+
+std::size_t storage_alignment(std::size_t words, bool huge_pages) {
+  bool huge = huge_pages && words * sizeof(BitSet::Word) >= BitSet::HUGE_PAGE_BYTES;
+  return huge ? BitSet::HUGE_PAGE_BYTES : BitSet::STORAGE_ALIGNMENT;
+}
+
+// Storage is rounded up to whole units of its alignment, so that no other allocation shares its last cache line or
+// huge page
+std::size_t storage_bytes(std::size_t words, std::size_t alignment) {
+  return (words * sizeof(BitSet::Word) + alignment - 1) / alignment * alignment;
+}
+
+// Whether storage for `words` words is mapped from the system rather than taken from the heap, so that it reads as zero
+// without being written
+bool mapped([[maybe_unused]] std::size_t words, [[maybe_unused]] bool huge_pages) {
+#if defined(__linux__)
+  return storage_bytes(words, storage_alignment(words, huge_pages)) >= BitSet::MAPPED_BYTES;
+#else
+  return false;
+#endif
+}
+
+#if defined(__linux__)
+// Maps `bytes` of zero pages, over-mapping by the alignment when it exceeds a page and trimming the excess
+void* map_storage(std::size_t bytes, std::size_t alignment) {
+  std::size_t slack = alignment > BitSet::STORAGE_ALIGNMENT ? alignment : 0;
+  void* raw = ::mmap(nullptr, bytes + slack, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  char* begin = static_cast<char*>(raw);
+  char* data = begin + (alignment - reinterpret_cast<std::uintptr_t>(begin) % alignment) % alignment;
+  if (data != begin) {
+    ::munmap(begin, static_cast<std::size_t>(data - begin));
+  }
+  if (begin + bytes + slack != data + bytes) {
+    ::munmap(data + bytes, static_cast<std::size_t>(begin + bytes + slack - (data + bytes)));
+  }
+  return data;
+}
+
+void unmap_storage(void* data, std::size_t bytes) {
+  ::munmap(data, bytes);
+}
+#else
+void* map_storage(std::size_t, std::size_t) {
+  throw std::bad_alloc();
+}
+
+void unmap_storage(void*, std::size_t) {}
+#endif
+
+} // namespace
+
+BitSet::BitSet()
+    : _data(nullptr)
+    , _size(0)
+    , _capacity(0)
+    , _dirty_words(0)
+    , _huge_pages(false)
+    , _tight_capacity(false) {}
+
+BitSet::BitSet(std::size_t size, bool value)
+    : BitSet(size, value, false, false) {}
+
+BitSet::BitSet(std::size_t size, bool value, HugePages)
+    : BitSet(size, value, true, false) {}
+
+BitSet::BitSet(std::size_t size, bool value, TightCapacity)
+    : BitSet(size, value, false, true) {}
+
+BitSet::BitSet(std::size_t size, bool value, bool huge_pages, bool tight_capacity)
+    : _data(allocate(detail::word_count(size), huge_pages))
+    , _size(size)
+    , _capacity(detail::word_count(size))
+    , _dirty_words(_capacity)
+    , _huge_pages(huge_pages)
+    , _tight_capacity(tight_capacity) {
+  if (value || !mapped(_capacity, huge_pages)) {
+    std::fill_n(_data, word_count(), value ? detail::ALL_ONES : Word(0));
+  }
+  clear_tail();
+}
+
+BitSet::BitSet(const BitSet& other)
+    : _data(allocate(other.word_count(), other._huge_pages))
+    , _size(other._size)
+    , _capacity(other.word_count())
+    , _dirty_words(std::min(_capacity, other._dirty_words))
+    , _huge_pages(other._huge_pages)
+    , _tight_capacity(other._tight_capacity) {
+  std::copy_n(other._data, _dirty_words, _data);
+  if (!mapped(_capacity, _huge_pages)) {
+    std::fill(_data + _dirty_words, _data + _capacity, Word(0));
+  }
+}
+
+BitSet::BitSet(std::string_view str)
+    : BitSet(str, false, false) {}
+
+BitSet::BitSet(std::string_view str, bool huge_pages, bool tight_capacity)
+    : _data(allocate(detail::word_count(str.size()), huge_pages))
+    , _size(str.size())
+    , _capacity(word_count())
+    , _dirty_words(_capacity)
+    , _huge_pages(huge_pages)
+    , _tight_capacity(tight_capacity) {
+  for (std::size_t i = 0; i < word_count(); ++i) {
+    std::string_view chunk = str.substr(i * detail::WORD_BITS, detail::WORD_BITS);
+    Word word = 0;
+    for (std::size_t j = 0; j < chunk.size(); ++j) {
+      if (chunk[j] == '1') {
+        word |= detail::bit_mask(j);
+      }
+    }
+    _data[i] = word;
+  }
+}
+
+BitSet::BitSet(const ConstView& other)
+    : BitSet(other, false, false) {}
+
+BitSet::BitSet(const ConstView& other, bool huge_pages, bool tight_capacity)
+    : _data(allocate(detail::word_count(other.size()), huge_pages))
+    , _size(other.size())
+    , _capacity(word_count())
+    , _dirty_words(_capacity)
+    , _huge_pages(huge_pages)
+    , _tight_capacity(tight_capacity) {
+  detail::transform(_data, 0, other.data(), other.offset(), _size, [](Word, Word src) { return src; });
+  clear_tail();
+}
+
+BitSet::BitSet(ConstIterator first, ConstIterator last)
+    : BitSet(ConstView(first, last)) {
+  detail::record(detail::Stat::ITERATOR_CONSTRUCTIONS);
+}
+
+BitSet BitSet::from_indices(std::span<const std::uint32_t> indices, std::size_t size) {
+  BitSet result(size, false);
+  result.subview().assign_indices(indices);
+  return result;
+}
+
+BitSet BitSet::from_indices(std::span<const std::uint64_t> indices, std::size_t size) {
+  BitSet result(size, false);
+  result.subview().assign_indices(indices);
+  return result;
+}
+
+BitSet& BitSet::operator=(const BitSet& other) & {
+  if (this != &other) {
+    BitSet(other).swap(*this);
+  }
+  return *this;
+}
+
+// Assigning a string or a view keeps the storage policy of the target
+BitSet& BitSet::operator=(std::string_view str) & {
+  BitSet(str, _huge_pages, _tight_capacity).swap(*this);
+  return *this;
+}
+
+BitSet& BitSet::operator=(const ConstView& other) & {
+  BitSet(other, _huge_pages, _tight_capacity).swap(*this);
+  return *this;
+}
+
+BitSet::~BitSet() {
+  deallocate(_data, _capacity, _huge_pages);
+}
+
+void BitSet::swap(BitSet& other) {
+  std::swap(_data, other._data);
+  std::swap(_size, other._size);
+  std::swap(_capacity, other._capacity);
+  std::swap(_dirty_words, other._dirty_words);
+  std::swap(_huge_pages, other._huge_pages);
+  std::swap(_tight_capacity, other._tight_capacity);
+}
+
+std::size_t BitSet::size() const {
+  return _size;
+}
+
+std::size_t BitSet::implicit_zeros() const {
+  return _size - stored().size();
+}
+
+BitSet::ConstView BitSet::stored() const {
+  return {_data, 0, std::min(_size, _dirty_words * detail::WORD_BITS)};
+}
+
+bool BitSet::empty() const {
+  return _size == 0;
+}
+
+bool BitSet::huge_pages() const {
+  return _huge_pages;
+}
+
+bool BitSet::tight_capacity() const {
+  return _tight_capacity;
+}
+
+std::size_t BitSet::capacity() const {
+  return _capacity * detail::WORD_BITS;
+}
+
+void BitSet::reserve(std::size_t capacity) {
+  std::size_t words = detail::word_count(capacity);
+  if (words > _capacity) {
+    reallocate(words);
+  }
+}
+
+void BitSet::shrink_to_fit() {
+  if (_capacity != word_count()) {
+    reallocate(word_count());
+  }
+}
+
+void BitSet::resize(std::size_t size, bool value) {
+  std::size_t old_size = _size;
+  resize_storage(size);
+  if (value && size > old_size) {
+    touch();
+    detail::fill(_data, old_size, size - old_size, true);
+  }
+}
+
+// The tail of the last word is zero, so a bit is appended with a single OR, and a zero without any write
+void BitSet::push_back(bool value) {
+  if (_size % detail::WORD_BITS == 0) {
+    grow(word_count() + 1);
+    if (word_count() < _dirty_words) {
+      _data[word_count()] = 0;
+    }
+  }
+  ++_size;
+  if (value) {
+    touch();
+    _data[(_size - 1) / detail::WORD_BITS] |= detail::bit_mask((_size - 1) % detail::WORD_BITS);
+  }
+}
+
+void BitSet::append_word(Word word) {
+  std::size_t index = _size / detail::WORD_BITS;
+  std::size_t shift = _size % detail::WORD_BITS;
+  resize_storage(_size + detail::WORD_BITS);
+  touch();
+  if (shift == 0) {
+    _data[index] = word;
+  } else {
+    _data[index] |= word >> shift;
+    _data[index + 1] = word << (detail::WORD_BITS - shift);
+  }
+}
+
+// Bits of this set are copied first, as growing may free the storage they live in
+BitSet& BitSet::append(const ConstView& bits) & {
+  if (std::less_equal<>()(_data, bits.data()) && std::less<>()(bits.data(), _data + _capacity)) {
+    return append(BitSet(bits));
+  }
+  std::size_t position = _size;
+  resize_storage(_size + bits.size());
+  touch();
+  detail::transform(_data, position, bits.data(), bits.offset(), bits.size(), [](Word, Word src) { return src; });
+  return *this;
+}
+
+BitSet::Reference BitSet::operator[](std::size_t index) {
+  touch();
+  return {_data + index / detail::WORD_BITS, detail::bit_mask(index % detail::WORD_BITS)};
+}
+
+BitSet::ConstReference BitSet::operator[](std::size_t index) const {
+  return {_data + index / detail::WORD_BITS, detail::bit_mask(index % detail::WORD_BITS)};
+}
+
+BitSet::Iterator BitSet::begin() {
+  touch();
+  return {_data, 0};
+}
+
+BitSet::ConstIterator BitSet::begin() const {
+  return {_data, 0};
+}
+
+BitSet::Iterator BitSet::end() {
+  touch();
+  return {_data, _size};
+}
+
+BitSet::ConstIterator BitSet::end() const {
+  return {_data, _size};
+}
+
+// Words that were never written stay zero, so they need no marking
+BitSet& BitSet::operator&=(const ConstView& other) & {
+  View(_data, 0, _size) &= other;
+  return *this;
+}
+
+BitSet& BitSet::operator|=(const ConstView& other) & {
+  subview() |= other;
+  return *this;
+}
+
+BitSet& BitSet::operator^=(const ConstView& other) & {
+  subview() ^= other;
+  return *this;
+}
+
+BitSet& BitSet::operator<<=(std::size_t count) & {
+  resize_storage(_size + count);
+  return *this;
+}
+
+BitSet& BitSet::operator>>=(std::size_t count) & {
+  resize_storage(_size - std::min(count, _size));
+  return *this;
+}
+
+BitSet& BitSet::flip() & {
+  touch();
+  std::for_each_n(_data, word_count(), [](Word& word) { word = ~word; });
+  clear_tail();
+  return *this;
+}
+
+BitSet& BitSet::shift_left(std::size_t count) & {
+  subview().shift_left(count);
+  return *this;
+}
+
+BitSet& BitSet::shift_right(std::size_t count) & {
+  subview().shift_right(count);
+  return *this;
+}
+
+BitSet& BitSet::rotate_left(std::size_t count) & {
+  subview().rotate_left(count);
+  return *this;
+}
+
+BitSet& BitSet::rotate_right(std::size_t count) & {
+  subview().rotate_right(count);
+  return *this;
+}
+
+BitSet& BitSet::reverse() & {
+  subview().reverse();
+  return *this;
+}
+
+BitSet& BitSet::set() & {
+  touch();
+  std::fill_n(_data, word_count(), detail::ALL_ONES);
+  clear_tail();
+  return *this;
+}
+
+BitSet& BitSet::reset() & {
+  std::fill_n(_data, word_count(), Word(0));
+  return *this;
+}
+
+bool BitSet::all() const {
+  return implicit_zeros() == 0 && subview().all();
+}
+
+bool BitSet::any() const {
+  std::size_t words = std::min(word_count(), _dirty_words);
+  return std::any_of(_data, _data + words, [](Word word) { return word != 0; });
+}
+
+std::size_t BitSet::count() const {
+  return stored().count();
+}
+
+BitSet& BitSet::set_bits(std::span<const std::size_t> indices) & {
+  subview().set_bits(indices);
+  return *this;
+}
+
+BitSet& BitSet::reset_bits(std::span<const std::size_t> indices) & {
+  subview().reset_bits(indices);
+  return *this;
+}
+
+BitSet& BitSet::flip_bits(std::span<const std::size_t> indices) & {
+  subview().flip_bits(indices);
+  return *this;
+}
+
+void BitSet::test_bits(std::span<const std::size_t> indices, std::span<bool> out) const {
+  subview().test_bits(indices, out);
+}
+
+void BitSet::test_bits(std::span<const std::size_t> indices, const View& out) const {
+  subview().test_bits(indices, out);
+}
+
+std::size_t BitSet::to_indices(std::span<std::uint32_t> out) const {
+  return stored().to_indices(out);
+}
+
+std::size_t BitSet::to_indices(std::span<std::uint64_t> out) const {
+  return stored().to_indices(out);
+}
+
+void BitSet::append_indices(std::vector<std::uint32_t>& out) const {
+  stored().append_indices(out);
+}
+
+void BitSet::append_indices(std::vector<std::uint64_t>& out) const {
+  stored().append_indices(out);
+}
+
+RunRange BitSet::runs() const {
+  return stored().runs();
+}
+
+RunRange BitSet::zero_runs() const {
+  return subview().zero_runs();
+}
+
+std::size_t BitSet::find_run(std::size_t min_length, bool value) const {
+  return subview().find_run(min_length, value);
+}
+
+BitSet::operator ConstView() const {
+  return {_data, 0, _size};
+}
+
+BitSet::operator View() {
+  touch();
+  return {_data, 0, _size};
+}
+
+BitSet::View BitSet::subview(std::size_t offset, std::size_t count) {
+  return View(*this).subview(offset, count);
+}
+
+BitSet::ConstView BitSet::subview(std::size_t offset, std::size_t count) const {
+  return ConstView(*this).subview(offset, count);
+}
+
+std::optional<BitSet::AlignedView> BitSet::subview_aligned(std::size_t offset, std::size_t count) {
+  touch();
+  return AlignedView(_data, _size).subview_aligned(offset, count);
+}
+
+std::optional<BitSet::AlignedConstView> BitSet::subview_aligned(std::size_t offset, std::size_t count) const {
+  return AlignedConstView(_data, _size).subview_aligned(offset, count);
+}
+
+// Huge pages are requested with `madvise`, which makes transparent huge pages back the range even when the system
+// enables them only on request. Where that is unavailable, the storage is just 2 MiB aligned.
+BitSet::Word* BitSet::allocate(std::size_t words, bool huge_pages) {
+  if (words == 0) {
+    return nullptr;
+  }
+  detail::record(detail::Stat::ALLOCATIONS);
+  detail::record(detail::Stat::ALLOCATED_BYTES, words * sizeof(Word));
+  std::size_t alignment = storage_alignment(words, huge_pages);
+  std::size_t bytes = storage_bytes(words, alignment);
+  void* data = mapped(words, huge_pages) ? map_storage(bytes, alignment)
+                                         : ::operator new(bytes, std::align_val_t(alignment));
+#if defined(MADV_HUGEPAGE)
+  if (alignment == HUGE_PAGE_BYTES) {
+    ::madvise(data, bytes, MADV_HUGEPAGE);
+  }
+#endif
+  return static_cast<Word*>(data);
+}
+
+void BitSet::deallocate(Word* data, std::size_t words, bool huge_pages) {
+  if (data == nullptr) {
+    return;
+  }
+  detail::record(detail::Stat::DEALLOCATIONS);
+  std::size_t alignment = storage_alignment(words, huge_pages);
+  if (mapped(words, huge_pages)) {
+    unmap_storage(data, storage_bytes(words, alignment));
+  } else {
+    ::operator delete(data, storage_bytes(words, alignment), std::align_val_t(alignment));
+  }
+}
+
+std::size_t BitSet::word_count() const {
+  return detail::word_count(_size);
+}
+
+// Called before the words in use may be written. Only the first call after zeros were appended writes anything, so
+// taking views of a set whose words are all marked leaves it untouched.
+void BitSet::touch() {
+  if (_dirty_words < word_count()) {
+    _dirty_words = word_count();
+  }
+}
+
+// Bits past the end of the last word are kept zero, so that whole-word operations need no masking
+void BitSet::clear_tail() {
+  std::size_t rest = _size % detail::WORD_BITS;
+  if (rest != 0) {
+    _data[_size / detail::WORD_BITS] &= detail::range_mask(0, rest);
+  }
+}
+
+// Changes the size, keeping the common prefix and zero-filling the new bits; only the new words that were written
+// before need it. Storage grows geometrically and is kept on shrinking, except with a tight capacity, where it is
+// reallocated whenever the number of words changes, so memory usage stays within `size + C` bits.
+void BitSet::resize_storage(std::size_t size) {
+  std::size_t old_words = word_count();
+  std::size_t new_words = detail::word_count(size);
+  if (new_words > old_words) {
+    grow(new_words);
+    std::fill(_data + old_words, _data + std::max(old_words, std::min(new_words, _dirty_words)), Word(0));
+  } else if (_tight_capacity && new_words != _capacity) {
+    reallocate(new_words);
+  }
+  _size = size;
+  clear_tail();
+}
+
+void BitSet::grow(std::size_t words) {
+  if (words > _capacity) {
+    reallocate(_tight_capacity ? words : std::max(words, 2 * _capacity));
+  }
+}
+
+// Moves the words in use to storage for `capacity` words, dropping the ones that do not fit. Words in use that were
+// never written are zero in both places and are not copied.
+void BitSet::reallocate(std::size_t capacity) {
+  Word* data = allocate(capacity, _huge_pages);
+  std::size_t copied = std::min({word_count(), _dirty_words, capacity});
+  std::copy_n(_data, copied, data);
+  if (!mapped(capacity, _huge_pages)) {
+    std::fill(data + copied, data + capacity, Word(0));
+  }
+  deallocate(std::exchange(_data, data), _capacity, _huge_pages);
+  _capacity = capacity;
+  _dirty_words = copied;
+}
+
+bool operator==(const BitSet& left, const BitSet& right) {
+  return left.size() == right.size() && std::is_eq(left <=> right);
+}
+
+bool operator!=(const BitSet& left, const BitSet& right) {
+  return !(left == right);
+}
+
+// The stored bits are compared up to the end of the shorter stored part. Past it, one side only has zeros, so the
+// other one is greater if it stores a one before the common length ends.
+std::strong_ordering operator<=>(const BitSet& left, const BitSet& right) {
+  BitSet::ConstView lhs = left.stored();
+  BitSet::ConstView rhs = right.stored();
+  std::size_t common = std::min(lhs.size(), rhs.size());
+  std::strong_ordering order = lhs.subview(0, common) <=> rhs.subview(0, common);
+  if (std::is_neq(order)) {
+    return order;
+  }
+  std::size_t length = std::min(left.size(), right.size());
+  if (lhs.subview(common, length - common).any()) {
+    return std::strong_ordering::greater;
+  }
+  if (rhs.subview(common, length - common).any()) {
+    return std::strong_ordering::less;
+  }
+  return left.size() <=> right.size();
+}
+
+bool operator==(const BitSet::ConstView& left, const BitSet::ConstView& right) {
+  return left.size() == right.size() &&
+         detail::equal(left.data(), left.offset(), right.data(), right.offset(), left.size());
+}
+
+bool operator!=(const BitSet::ConstView& left, const BitSet::ConstView& right) {
+  return !(left == right);
+}
+
+std::strong_ordering operator<=>(const BitSet::ConstView& left, const BitSet::ConstView& right) {
+  return detail::compare(left.data(), left.offset(), left.size(), right.data(), right.offset(), right.size());
+}
+
+BitSet operator&(const BitSet::ConstView& left, const BitSet::ConstView& right) {
+  BitSet result(left);
+  result &= right;
+  return result;
+}
+
+BitSet operator|(const BitSet::ConstView& left, const BitSet::ConstView& right) {
+  BitSet result(left);
+  result |= right;
+  return result;
+}
+
+BitSet operator^(const BitSet::ConstView& left, const BitSet::ConstView& right) {
+  BitSet result(left);
+  result ^= right;
+  return result;
+}
+
+BitSet operator~(const BitSet::ConstView& view) {
+  BitSet result(view);
+  result.flip();
+  return result;
+}
+
+BitSet operator<<(const BitSet::ConstView& view, std::size_t count) {
+  BitSet result(view);
+  result <<= count;
+  return result;
+}
+
+BitSet operator>>(const BitSet::ConstView& view, std::size_t count) {
+  return BitSet(view.subview(0, view.size() - std::min(count, view.size())));
+}
+
+BitSet reversed(const BitSet::ConstView& view) {
+  BitSet result(view.size(), false);
+  detail::transform_reversed(
+      BitSet::View(result).data(),
+      0,
+      view.data(),
+      view.offset(),
+      view.size(),
+      [](BitSet::Word, BitSet::Word src) { return src; }
+  );
+  return result;
+}
+
+void swap(BitSet& lhs, BitSet& rhs) {
+  lhs.swap(rhs);
+}
+
+std::string to_string(const BitSet::ConstView& view) {
+  std::string result;
+  result.reserve(view.size());
+  detail::for_each_chunk(view.data(), view.offset(), view.size(), [&result](BitSet::Word chunk, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      result.push_back((chunk & detail::bit_mask(i)) != 0 ? '1' : '0');
+    }
+  });
+  return result;
+}
+
+std::ostream& operator<<(std::ostream& out, const BitSet::ConstView& view) {
+  return out << to_string(view);
+}
+
+std::string to_string(const BitSet& bs) {
+  std::string result = to_string(bs.stored());
+  result.append(bs.implicit_zeros(), '0');
+  return result;
+}
+
+std::ostream& operator<<(std::ostream& out, const BitSet& bs) {
+  return out << to_string(bs);
+}
+
+std::size_t BitSetHash::operator()(const BitSet::ConstView& view) const {
+  return detail::hash(view.data(), view.offset(), view.size());
+}
 
 } // namespace ct
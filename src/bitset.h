@@ -1,30 +1,85 @@
 #pragma once
 
+#include "bitset-aligned.h"
+#include "bitset-iterator.h"
+#include "bitset-reference.h"
+#include "bitset-runs.h"
+#include "bitset-view.h"
+#include "bitset-words.h"
+
+#include <compare>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <span>
+#include <string>
 #include <string_view>
+#include <vector>
 
 namespace ct {
 
+// Constructor tag requesting huge pages for the storage of a large bitset, see `BitSet::HUGE_PAGE_BYTES`
+struct HugePages {
+  explicit HugePages() = default;
+};
+
+inline constexpr HugePages HUGE_PAGES{};
+
+// Constructor tag keeping the storage of a bitset within `size + C` bits: every change of the number of words
+// reallocates, so growth is not amortized. Like `HUGE_PAGES`, it is kept when a string or a view is assigned.
+struct TightCapacity {
+  explicit TightCapacity() = default;
+};
+
+inline constexpr TightCapacity TIGHT_CAPACITY{};
+
+// Storage is aligned to a cache line. A bitset constructed with `HUGE_PAGES` keeps its words in 2 MiB aligned memory
+// once they take at least `HUGE_PAGE_BYTES`, and asks the kernel to back it with huge pages, which cuts TLB misses on
+// random access to large sets. The policy is carried along by copies, and kept when the size changes and when a string
+// or a view is assigned.
+//
+// Growing operations at least double the capacity when they run out of it, so building a set bit by bit takes
+// amortized constant time per bit. Shrinking keeps the capacity until `shrink_to_fit`. Copies get no spare capacity.
+//
+// Words past the ones written since the last reallocation are kept zero, and storage of at least `MAPPED_BYTES` is
+// mapped from the system, whose pages read as zero until written. So appending zeros with `<<=`, `resize` or
+// `push_back` writes nothing but the words that held bits before, and a reallocation copies only the words that were
+// written. Counts, comparisons, printing and index extraction stop at the written words too, so the appended zeros
+// cost them nothing. The first mutable access afterwards (a view, an iterator or a reference) marks all words as
+// written; const access never changes the set.
 class BitSet {
 public:
   using Value = bool;
-  using Reference = void;
-  using ConstReference = void;
-  using Iterator = void;
-  using ConstIterator = void;
-  using View = void;
-  using ConstView = void;
-  using Word = void;
+  using Word = detail::Word;
+  using Reference = BitReference<Word>;
+  using ConstReference = BitReference<const Word>;
+  using Iterator = BitIterator<Word>;
+  using ConstIterator = BitIterator<const Word>;
+  using View = BitView<Word>;
+  using ConstView = BitView<const Word>;
+  using AlignedView = AlignedBitView<Word>;
+  using AlignedConstView = AlignedBitView<const Word>;
 
   static constexpr std::size_t NPOS = -1;
+  static constexpr std::size_t STORAGE_ALIGNMENT = 64;
+  static constexpr std::size_t HUGE_PAGE_BYTES = std::size_t(2) << 20;
+  static constexpr std::size_t MAPPED_BYTES = std::size_t(128) << 10;
 
   BitSet();
   BitSet(std::size_t size, bool value);
+  BitSet(std::size_t size, bool value, HugePages);
+  BitSet(std::size_t size, bool value, TightCapacity);
   BitSet(const BitSet& other);
   explicit BitSet(std::string_view str);
   explicit BitSet(const ConstView& other);
   BitSet(ConstIterator first, ConstIterator last);
 
+  // `size` bits with ones exactly at the listed positions, preferably sorted
+  static BitSet from_indices(std::span<const std::uint32_t> indices, std::size_t size);
+  static BitSet from_indices(std::span<const std::uint64_t> indices, std::size_t size);
+
   BitSet& operator=(const BitSet& other) &;
   BitSet& operator=(std::string_view str) &;
   BitSet& operator=(const ConstView& other) &;
@@ -35,6 +90,24 @@ public:
 
   std::size_t size() const;
   bool empty() const;
+  bool huge_pages() const;
+  bool tight_capacity() const;
+
+  // Number of bits the storage holds without reallocation
+  std::size_t capacity() const;
+  void reserve(std::size_t capacity);
+  void shrink_to_fit();
+
+  // Trailing zeros in words that were never written, and a view of the bits before them
+  std::size_t implicit_zeros() const;
+  ConstView stored() const;
+
+  // New bits are set to `value`
+  void resize(std::size_t size, bool value = false);
+  void push_back(bool value);
+  // Appends the bits of `word`, most significant first; at a multiple of the word width this is a single store
+  void append_word(Word word);
+  BitSet& append(const ConstView& bits) &;
 
   Reference operator[](std::size_t index);
   ConstReference operator[](std::size_t index) const;
@@ -52,6 +125,13 @@ public:
   BitSet& operator>>=(std::size_t count) &;
   BitSet& flip() &;
 
+  // Unlike `<<=` and `>>=`, these keep the size; see `View::shift_left`
+  BitSet& shift_left(std::size_t count) &;
+  BitSet& shift_right(std::size_t count) &;
+  BitSet& rotate_left(std::size_t count) &;
+  BitSet& rotate_right(std::size_t count) &;
+  BitSet& reverse() &;
+
   BitSet& set() &;
   BitSet& reset() &;
 
@@ -59,16 +139,98 @@ public:
   bool any() const;
   std::size_t count() const;
 
+  BitSet& set_bits(std::span<const std::size_t> indices) &;
+  BitSet& reset_bits(std::span<const std::size_t> indices) &;
+  BitSet& flip_bits(std::span<const std::size_t> indices) &;
+  void test_bits(std::span<const std::size_t> indices, std::span<bool> out) const;
+  void test_bits(std::span<const std::size_t> indices, const View& out) const;
+
+  std::size_t to_indices(std::span<std::uint32_t> out) const;
+  std::size_t to_indices(std::span<std::uint64_t> out) const;
+  void append_indices(std::vector<std::uint32_t>& out) const;
+  void append_indices(std::vector<std::uint64_t>& out) const;
+
+  RunRange runs() const;
+  RunRange zero_runs() const;
+  std::size_t find_run(std::size_t min_length, bool value = false) const;
+
   operator ConstView() const;
   operator View();
 
   View subview(std::size_t offset = 0, std::size_t count = NPOS);
   ConstView subview(std::size_t offset = 0, std::size_t count = NPOS) const;
+
+  // Same as `subview` for an `offset` that is a multiple of the word width, and nothing otherwise
+  std::optional<AlignedView> subview_aligned(std::size_t offset = 0, std::size_t count = NPOS);
+  std::optional<AlignedConstView> subview_aligned(std::size_t offset = 0, std::size_t count = NPOS) const;
+
+private:
+  BitSet(std::size_t size, bool value, bool huge_pages, bool tight_capacity);
+  BitSet(std::string_view str, bool huge_pages, bool tight_capacity);
+  BitSet(const ConstView& other, bool huge_pages, bool tight_capacity);
+
+  static Word* allocate(std::size_t words, bool huge_pages);
+  static void deallocate(Word* data, std::size_t words, bool huge_pages);
+
+  std::size_t word_count() const;
+  void touch();
+  void clear_tail();
+  void resize_storage(std::size_t size);
+  void grow(std::size_t words);
+  void reallocate(std::size_t capacity);
+
+private:
+  Word* _data;
+  std::size_t _size;
+  std::size_t _capacity;
+  // Words at the start of the storage that may be nonzero; the rest of the capacity is zero
+  std::size_t _dirty_words;
+  bool _huge_pages;
+  bool _tight_capacity;
 };
 
 bool operator==(const BitSet& left, const BitSet& right);
 bool operator!=(const BitSet& left, const BitSet& right);
+std::strong_ordering operator<=>(const BitSet& left, const BitSet& right);
+
+bool operator==(const BitSet::ConstView& left, const BitSet::ConstView& right);
+bool operator!=(const BitSet::ConstView& left, const BitSet::ConstView& right);
+std::strong_ordering operator<=>(const BitSet::ConstView& left, const BitSet::ConstView& right);
+
+BitSet operator&(const BitSet::ConstView& left, const BitSet::ConstView& right);
+BitSet operator|(const BitSet::ConstView& left, const BitSet::ConstView& right);
+BitSet operator^(const BitSet::ConstView& left, const BitSet::ConstView& right);
+BitSet operator~(const BitSet::ConstView& view);
+BitSet operator<<(const BitSet::ConstView& view, std::size_t count);
+BitSet operator>>(const BitSet::ConstView& view, std::size_t count);
+
+// Copy of the view with the bits in reverse order, built one word at a time
+BitSet reversed(const BitSet::ConstView& view);
 
 void swap(BitSet& lhs, BitSet& rhs);
 
+std::string to_string(const BitSet::ConstView& view);
+std::ostream& operator<<(std::ostream& out, const BitSet::ConstView& view);
+
+// Print the implicit zeros without reading their words
+std::string to_string(const BitSet& bs);
+std::ostream& operator<<(std::ostream& out, const BitSet& bs);
+
+// Hashes the logical bits, so equal bitsets and views hash equally regardless of their alignment in storage.
+// Transparent, so that a container of `BitSet` keyed with `std::equal_to<>` can be searched by a view.
+struct BitSetHash {
+  using is_transparent = void;
+
+  std::size_t operator()(const BitSet::ConstView& view) const;
+};
+
 } // namespace ct
+
+template <>
+struct std::hash<ct::BitSet> : ct::BitSetHash {};
+
+template <>
+struct std::hash<ct::BitSet::View> : ct::BitSetHash {};
+
+template <>
+struct std::hash<ct::BitSet::ConstView> : ct::BitSetHash {};
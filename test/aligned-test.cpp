@@ -0,0 +1,141 @@
+#include "bitset.h"
+#include "test-helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+
+namespace ct::test {
+
+namespace {
+
+BitSet random_bits(std::size_t size, std::mt19937_64& rng) {
+  BitSet result(size, false);
+  for (std::size_t i = 0; i < size; ++i) {
+    result[i] = (rng() & 1) != 0;
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("aligned subviews are checked") {
+  BitSet bs(300, true);
+  const BitSet& readonly = bs;
+
+  CHECK(bs.subview_aligned(64, 100).has_value());
+  CHECK(readonly.subview_aligned(128).has_value());
+  CHECK_FALSE(bs.subview_aligned(3).has_value());
+  CHECK_FALSE(readonly.subview_aligned(65, 10).has_value());
+  CHECK(bs.subview_aligned(128)->size() == 172);
+  CHECK(bs.subview_aligned(320)->empty());
+
+  BitSet::View view = bs.subview(10);
+  CHECK(subview_aligned(view, 54, 20).has_value());
+  CHECK_FALSE(subview_aligned(view, 64).has_value());
+  CHECK(subview_aligned(BitSet::ConstView(bs), 0, 5)->size() == 5);
+
+  std::optional<BitSet::AlignedView> aligned = bs.subview_aligned(64);
+  REQUIRE(aligned.has_value());
+  CHECK(aligned->subview_aligned(128, 10)->data() == aligned->data() + 2);
+  CHECK_FALSE(aligned->subview_aligned(1).has_value());
+}
+
+TEST_CASE("aligned views match general views") {
+  std::size_t size = GENERATE(0, 1, 63, 64, 100, 640, 1'000);
+  CAPTURE(size);
+  std::mt19937_64 rng(size);
+
+  const BitSet source = random_bits(size + 128, rng);
+  BitSet expected = random_bits(size + 128, rng);
+  BitSet actual = expected;
+  BitSet::View expected_view = expected.subview(64, size);
+  BitSet::AlignedView actual_view = *actual.subview_aligned(64, size);
+  BitSet::AlignedConstView other = *source.subview_aligned(0, size);
+
+  CHECK(actual_view.count() == expected_view.count());
+  CHECK(actual_view.all() == expected_view.all());
+  CHECK(actual_view.any() == expected_view.any());
+
+  SECTION("bitwise operations") {
+    expected_view &= source.subview(0, size);
+    actual_view &= other;
+    CHECK(actual == expected);
+    expected_view |= source.subview(0, size);
+    actual_view |= other;
+    CHECK(actual == expected);
+    expected_view ^= source.subview(0, size);
+    actual_view ^= *source.subview_aligned(0, size);
+    CHECK(actual == expected);
+  }
+
+  SECTION("misaligned operand") {
+    expected_view ^= source.subview(5, size);
+    actual_view ^= source.subview(5, size);
+    CHECK(actual == expected);
+  }
+
+  SECTION("fill") {
+    expected_view.set();
+    actual_view.set();
+    CHECK(actual == expected);
+    expected_view.flip();
+    actual_view.flip();
+    CHECK(actual == expected);
+    expected_view.flip();
+    actual_view.flip();
+    expected_view.reset();
+    actual_view.reset();
+    CHECK(actual == expected);
+  }
+
+  CHECK(actual_view == *expected.subview_aligned(64, size));
+  CHECK(BitSet(actual_view) == BitSet(expected_view));
+}
+
+TEST_CASE("aligned views compare their bits only") {
+  BitSet lhs("1011001110");
+  BitSet rhs("1011001111");
+  CHECK(*lhs.subview_aligned(0, 9) == *rhs.subview_aligned(0, 9));
+  CHECK(*lhs.subview_aligned(0, 10) != *rhs.subview_aligned(0, 10));
+  CHECK(*lhs.subview_aligned(0, 9) != *rhs.subview_aligned(0, 8));
+}
+
+TEST_CASE("aligned views work with general view APIs") {
+  BitSet bs("0110100111");
+  BitSet::AlignedView aligned = *bs.subview_aligned();
+  BitSet::AlignedConstView readonly = aligned;
+
+  CHECK(to_string(aligned) == "0110100111");
+  CHECK(to_string(readonly.subview(2, 5)) == "10100");
+  CHECK(aligned[1]);
+  aligned[0] = true;
+  CHECK(BitSet(readonly) == BitSet("1110100111"));
+
+  BitSet::View view = aligned;
+  view.subview(8).flip();
+  CHECK(to_string(readonly) == "1110100100");
+  CHECK((readonly ^ bs) == BitSet(10, false));
+
+  std::vector<std::uint64_t> indices;
+  BitSet::ConstView(readonly).append_indices(indices);
+  CHECK(indices == std::vector<std::uint64_t>{0, 1, 2, 4, 7});
+}
+
+TEST_CASE("aligned views use aligned kernels only") {
+  if constexpr (detail::STATS_ENABLED) {
+    BitSet lhs(64 * 10 + 5, true);
+    const BitSet rhs(64 * 10 + 5, false);
+
+    reset_bitset_stats();
+    *lhs.subview_aligned() &= *rhs.subview_aligned();
+    BitSetStats stats = bitset_stats();
+    CHECK(stats.transform == KernelStats{10, 0, 1});
+  }
+}
+
+} // namespace ct::test
@@ -0,0 +1,105 @@
+#include "bitset.h"
+#include "test-helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <random>
+#include <vector>
+
+namespace ct::test {
+
+TEST_CASE("batched set/reset/flip") {
+  std::string str = "11110110111010000100101111101000011011111111000001100110010010001011100100110101";
+  BitSet bs(str);
+  std::vector<std::size_t> indices = {79, 0, 3, 3, 64, 5, 63, 4};
+
+  SECTION("set") {
+    bs.set_bits(indices);
+    for (std::size_t index : indices) {
+      str[index] = '1';
+    }
+    CHECK_THAT(bs, BitSetEqualsString(str));
+  }
+
+  SECTION("reset") {
+    bs.reset_bits(indices);
+    for (std::size_t index : indices) {
+      str[index] = '0';
+    }
+    CHECK_THAT(bs, BitSetEqualsString(str));
+  }
+
+  SECTION("flip") {
+    bs.flip_bits(indices);
+    for (std::size_t index : indices) {
+      str[index] = (str[index] == '1') ? '0' : '1';
+    }
+    CHECK_THAT(bs, BitSetEqualsString(str));
+  }
+}
+
+TEST_CASE("batched access on a misaligned view") {
+  std::string str = "11110110111010000100101111101000011011111111000001100110010010001011100100110101";
+  BitSet bs(str);
+  BitSet::View view = bs.subview(7, 70);
+  std::vector<std::size_t> indices = {0, 69, 56, 57, 1, 2};
+
+  view.flip_bits(indices);
+  for (std::size_t index : indices) {
+    str[7 + index] = (str[7 + index] == '1') ? '0' : '1';
+  }
+  CHECK_THAT(bs, BitSetEqualsString(str));
+
+  std::vector<bool> expected;
+  for (std::size_t index : indices) {
+    expected.push_back(str[7 + index] == '1');
+  }
+
+  bool out[6] = {};
+  view.test_bits(indices, out);
+  CHECK(std::vector<bool>(std::begin(out), std::end(out)) == expected);
+
+  BitSet out_bits(10, true);
+  view.test_bits(indices, out_bits.subview(3, indices.size()));
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    CAPTURE(i);
+    CHECK(out_bits[3 + i] == expected[i]);
+  }
+  CHECK(out_bits[2]);
+  CHECK(out_bits[9]);
+}
+
+TEST_CASE("batched access matches per-bit access") {
+  auto [size, batch] = GENERATE(table<std::size_t, std::size_t>({
+      {1, 1},
+      {1, 70},
+      {100, 70},
+      {10'000, 5'000},
+      {std::size_t(1) << 26, std::size_t(1) << 16},
+  }));
+  CAPTURE(size, batch);
+
+  std::mt19937_64 rng(size * batch);
+  std::uniform_int_distribution<std::size_t> distribution(0, size - 1);
+  std::vector<std::size_t> indices(batch);
+  for (std::size_t& index : indices) {
+    index = distribution(rng);
+  }
+
+  BitSet expected(size, false);
+  BitSet actual(size, false);
+  for (std::size_t index : indices) {
+    expected[index].flip();
+  }
+  actual.flip_bits(indices);
+  REQUIRE(actual == expected);
+
+  BitSet out(batch, false);
+  actual.test_bits(indices, out);
+  for (std::size_t i = 0; i < batch; ++i) {
+    REQUIRE(out[i] == expected[indices[i]]);
+  }
+}
+
+} // namespace ct::test
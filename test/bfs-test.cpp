@@ -0,0 +1,171 @@
+#include "bitset-bfs.h"
+#include "test-helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace ct::test {
+
+namespace {
+
+constexpr std::uint32_t UNREACHED = -1;
+
+struct Graph {
+  std::vector<std::uint64_t> offsets;
+  std::vector<std::uint32_t> targets;
+
+  Graph(std::size_t vertices, const std::vector<std::pair<std::uint32_t, std::uint32_t>>& edges)
+      : offsets(vertices + 1, 0) {
+    for (auto [from, to] : edges) {
+      ++offsets[from + 1];
+    }
+    for (std::size_t i = 0; i < vertices; ++i) {
+      offsets[i + 1] += offsets[i];
+    }
+    targets.resize(edges.size());
+    std::vector<std::uint64_t> position(offsets.begin(), offsets.end() - 1);
+    for (auto [from, to] : edges) {
+      targets[position[from]++] = to;
+    }
+  }
+
+  CsrGraph csr() const {
+    return {offsets, targets};
+  }
+};
+
+// Undirected graph with `edges` random edges, each stored in both directions
+Graph random_graph(std::size_t vertices, std::size_t edges, std::uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<std::uint32_t> vertex(0, static_cast<std::uint32_t>(vertices - 1));
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> list;
+  for (std::size_t i = 0; i < edges; ++i) {
+    std::uint32_t from = vertex(rng);
+    std::uint32_t to = vertex(rng);
+    list.emplace_back(from, to);
+    list.emplace_back(to, from);
+  }
+  return Graph(vertices, list);
+}
+
+std::vector<std::uint32_t> reference_levels(const CsrGraph& graph, std::uint32_t source) {
+  std::vector<std::uint32_t> levels(graph.vertices(), UNREACHED);
+  std::deque<std::uint32_t> queue = {source};
+  levels[source] = 0;
+  while (!queue.empty()) {
+    std::uint32_t vertex = queue.front();
+    queue.pop_front();
+    for (std::uint32_t neighbour : graph.neighbours(vertex)) {
+      if (levels[neighbour] == UNREACHED) {
+        levels[neighbour] = levels[vertex] + 1;
+        queue.push_back(neighbour);
+      }
+    }
+  }
+  return levels;
+}
+
+// The parents must form a shortest path tree over the edges of the graph
+void check_search(const BreadthFirstSearch& search, const CsrGraph& graph, std::uint32_t source) {
+  std::vector<std::uint32_t> levels = reference_levels(graph, source);
+  std::span<const std::uint32_t> parents = search.parents();
+  REQUIRE(parents.size() == graph.vertices());
+  CHECK(parents[source] == source);
+  for (std::uint32_t vertex = 0; vertex < graph.vertices(); ++vertex) {
+    CAPTURE(vertex);
+    REQUIRE(search.visited()[vertex] == (levels[vertex] != UNREACHED));
+    if (levels[vertex] == UNREACHED) {
+      CHECK(parents[vertex] == BreadthFirstSearch::NO_PARENT);
+    } else if (vertex != source) {
+      std::uint32_t parent = parents[vertex];
+      REQUIRE(parent < graph.vertices());
+      CHECK(levels[parent] + 1 == levels[vertex]);
+      std::span<const std::uint32_t> neighbours = graph.neighbours(parent);
+      CHECK(std::ranges::find(neighbours, vertex) != neighbours.end());
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("bfs over a dense frontier switches to bottom-up steps") {
+  std::size_t threads = GENERATE(1, 3);
+  CAPTURE(threads);
+  Graph graph = random_graph(100'000, 800'000, 1);
+  BreadthFirstSearch search(graph.csr(), threads);
+
+  for (std::uint32_t source : {0u, 12'345u, 99'999u}) {
+    CAPTURE(source);
+    search.run(source);
+    check_search(search, graph.csr(), source);
+    CHECK(search.top_down_steps() > 0);
+    CHECK(search.bottom_up_steps() > 0);
+  }
+}
+
+// Large enough for steps in both directions to be split between threads: the bottom-up ones have 9'375 words and the
+// widest top-down one tens of thousands of queued vertices, over twice the smallest share of a thread
+TEST_CASE("bfs splits large steps between threads") {
+  Graph graph = random_graph(600'000, 2'400'000, 2);
+  BreadthFirstSearch single(graph.csr());
+  BreadthFirstSearch parallel(graph.csr(), 3);
+
+  for (std::uint32_t source : {0u, 456'789u}) {
+    CAPTURE(source);
+    single.run(source);
+    parallel.run(source);
+    check_search(parallel, graph.csr(), source);
+    CHECK(parallel.visited() == single.visited());
+    CHECK(parallel.top_down_steps() == single.top_down_steps());
+    CHECK(parallel.bottom_up_steps() == single.bottom_up_steps());
+    CHECK(parallel.bottom_up_steps() > 0);
+  }
+}
+
+TEST_CASE("bfs over a path expands sparse frontiers top-down") {
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+  for (std::uint32_t i = 0; i + 1 < 1'000; ++i) {
+    edges.emplace_back(i, i + 1);
+    edges.emplace_back(i + 1, i);
+  }
+  Graph graph(1'000, edges);
+  BreadthFirstSearch search(graph.csr());
+
+  search.run(500);
+  check_search(search, graph.csr(), 500);
+  CHECK(search.top_down_steps() + search.bottom_up_steps() == 501);
+  CHECK(search.top_down_steps() > 400);
+}
+
+TEST_CASE("bfs over a directed graph uses incoming edges") {
+  // Every vertex points to the next one and to vertex zero; vertex 130 is only reachable from itself
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> out_edges;
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> in_edges;
+  for (std::uint32_t i = 0; i < 131; ++i) {
+    for (std::uint32_t to : {(i + 1) % 130, 0u}) {
+      out_edges.emplace_back(i, to);
+      in_edges.emplace_back(to, i);
+    }
+  }
+  Graph out(131, out_edges);
+  Graph in(131, in_edges);
+  BreadthFirstSearch search(out.csr(), in.csr());
+
+  search.run(7);
+  check_search(search, out.csr(), 7);
+  CHECK_FALSE(search.visited()[130]);
+  CHECK(search.visited().count() == 130);
+
+  search.run(130);
+  check_search(search, out.csr(), 130);
+  CHECK(search.visited().count() == 131);
+}
+
+} // namespace ct::test
@@ -0,0 +1,103 @@
+#include "bitset-bloom.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace ct::test {
+
+namespace {
+
+std::vector<std::uint64_t> random_hashes(std::size_t count, std::mt19937_64& rng) {
+  std::vector<std::uint64_t> result(count);
+  for (std::uint64_t& hash : result) {
+    hash = rng();
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("bloom filter size") {
+  CHECK(BlockedBloomFilter(0).bits().size() == BlockedBloomFilter::BLOCK_BITS);
+  CHECK(BlockedBloomFilter(1).bits().size() == BlockedBloomFilter::BLOCK_BITS);
+  CHECK(BlockedBloomFilter(513).bits().size() == 2 * BlockedBloomFilter::BLOCK_BITS);
+  CHECK(BlockedBloomFilter(1024).bits().size() == 2 * BlockedBloomFilter::BLOCK_BITS);
+}
+
+TEST_CASE("bloom filter has no false negatives") {
+  std::mt19937_64 rng(1);
+  std::vector<std::uint64_t> keys = random_hashes(10'000, rng);
+  std::vector<std::uint64_t> others = random_hashes(10'000, rng);
+  BlockedBloomFilter filter(keys.size() * 10);
+
+  filter.insert(std::span(keys).first(5'000));
+  for (std::size_t i = 5'000; i < keys.size(); ++i) {
+    filter.insert(keys[i]);
+  }
+
+  std::unique_ptr<bool[]> found = std::make_unique<bool[]>(keys.size());
+  filter.contains(keys, std::span(found.get(), keys.size()));
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    CAPTURE(i);
+    CHECK(filter.contains(keys[i]));
+    CHECK(found[i]);
+  }
+
+  // About 1% for ten bits per key with eight probes in a block
+  std::size_t false_positives = 0;
+  for (std::uint64_t hash : others) {
+    false_positives += filter.contains(hash);
+  }
+  CHECK(false_positives < others.size() / 50);
+
+  filter.clear();
+  CHECK_FALSE(filter.bits().any());
+}
+
+TEST_CASE("bloom filter union and intersection") {
+  std::mt19937_64 rng(2);
+  std::vector<std::uint64_t> left_keys = random_hashes(1'000, rng);
+  std::vector<std::uint64_t> right_keys = random_hashes(1'000, rng);
+  BlockedBloomFilter left(20'000);
+  BlockedBloomFilter right(20'000);
+  left.insert(left_keys);
+  right.insert(right_keys);
+  right.insert(left_keys[0]);
+
+  BlockedBloomFilter both = left;
+  both |= right;
+  for (std::uint64_t hash : left_keys) {
+    CHECK(both.contains(hash));
+  }
+  for (std::uint64_t hash : right_keys) {
+    CHECK(both.contains(hash));
+  }
+
+  BlockedBloomFilter common = left;
+  common &= right;
+  CHECK(common.contains(left_keys[0]));
+  CHECK(common.bits().count() < left.bits().count());
+}
+
+TEST_CASE("bloom filter serialization") {
+  std::mt19937_64 rng(3);
+  std::vector<std::uint64_t> keys = random_hashes(1'000, rng);
+  BlockedBloomFilter filter(10'000);
+  filter.insert(keys);
+
+  BlockedBloomFilter restored(BitSet(to_string(filter.bits())));
+  CHECK(restored.bits() == filter.bits());
+  for (std::uint64_t hash : keys) {
+    CHECK(restored.contains(hash));
+  }
+
+  CHECK_THROWS_AS(BlockedBloomFilter(BitSet()), std::invalid_argument);
+  CHECK_THROWS_AS(BlockedBloomFilter(BitSet(BlockedBloomFilter::BLOCK_BITS + 1, false)), std::invalid_argument);
+  CHECK_THROWS_AS(BlockedBloomFilter(filter.bits().subview(1)), std::invalid_argument);
+}
+
+} // namespace ct::test
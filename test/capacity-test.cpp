@@ -0,0 +1,229 @@
+#include "bitset.h"
+#include "test-helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <string>
+#include <utility>
+
+namespace ct::test {
+
+TEST_CASE("bitset capacity") {
+  BitSet bs;
+  CHECK(bs.capacity() == 0);
+
+  bs.reserve(100);
+  CHECK(bs.capacity() >= 100);
+  CHECK(bs.empty());
+
+  const BitSet::Word* data = bs.subview().data();
+  bs <<= 100;
+  CHECK(bs.subview().data() == data);
+  CHECK_THAT(bs, BitSetEqualsString(std::string(100, '0')));
+
+  bs >>= 90;
+  CHECK(bs.capacity() >= 100);
+  CHECK(bs.subview().data() == data);
+
+  bs.shrink_to_fit();
+  CHECK(bs.capacity() == 64);
+  CHECK_THAT(bs, BitSetEqualsString(std::string(10, '0')));
+
+  CHECK(BitSet(bs).capacity() == 64);
+}
+
+TEST_CASE("bitset resize") {
+  BitSet bs("1011");
+
+  bs.resize(70, true);
+  CHECK_THAT(bs, BitSetEqualsString("1011" + std::string(66, '1')));
+
+  bs.resize(3);
+  CHECK_THAT(bs, BitSetEqualsString("101"));
+
+  bs.resize(130);
+  CHECK_THAT(bs, BitSetEqualsString("101" + std::string(127, '0')));
+  CHECK(bs.count() == 2);
+}
+
+TEST_CASE("bitset push_back") {
+  std::string str;
+  BitSet bs;
+  std::size_t reallocations = 0;
+  for (std::size_t i = 0; i < 1'000; ++i) {
+    bool value = (i % 3 == 0) || (i % 7 == 0);
+    std::size_t capacity = bs.capacity();
+    bs.push_back(value);
+    str += value ? '1' : '0';
+    reallocations += (bs.capacity() != capacity);
+  }
+  CHECK_THAT(bs, BitSetEqualsString(str));
+  CHECK(reallocations <= 5);
+  CHECK(bs.capacity() < 2 * 1'000 + 64);
+}
+
+TEST_CASE("bitset append") {
+  std::string str = "11110110111010000100101111101000011011111111000001100110010010001011100100110101";
+  BitSet bs("101");
+
+  SECTION("view") {
+    const BitSet other(str);
+    bs.append(other.subview(5, 70));
+    CHECK_THAT(bs, BitSetEqualsString("101" + str.substr(5, 70)));
+  }
+
+  SECTION("itself") {
+    bs.append(BitSet(str));
+    bs.append(bs);
+    bs.append(bs.subview(1, 4));
+    std::string expected = "101" + str;
+    expected += expected;
+    expected += expected.substr(1, 4);
+    CHECK_THAT(bs, BitSetEqualsString(expected));
+  }
+
+  SECTION("empty") {
+    bs.append(BitSet());
+    CHECK_THAT(bs, BitSetEqualsString("101"));
+  }
+
+  SECTION("words") {
+    const BitSet other(str);
+    bs.append_word(other.subview(0, 64).data()[0]);
+    bs.resize(64);
+    bs.append_word(other.subview(0, 64).data()[0]);
+    CHECK_THAT(bs, BitSetEqualsString("101" + str.substr(0, 61) + str.substr(0, 64)));
+  }
+}
+
+TEST_CASE("bitset with tight capacity") {
+  BitSet bs(10, true, TIGHT_CAPACITY);
+  CHECK(bs.tight_capacity());
+
+  bs <<= 100;
+  CHECK(bs.capacity() == 128);
+  bs.push_back(true);
+  CHECK(bs.capacity() == 128);
+  bs.append(BitSet(20, true));
+  CHECK(bs.capacity() == 192);
+  CHECK(bs.count() == 31);
+
+  bs >>= 100;
+  CHECK(bs.capacity() == 64);
+  CHECK(bs.count() == 10);
+
+  BitSet copy = bs;
+  CHECK(copy.tight_capacity());
+  CHECK_FALSE(BitSet(10, true).tight_capacity());
+
+  copy = BitSet(200, true).subview(3);
+  CHECK(copy.tight_capacity());
+  CHECK(copy.capacity() == 256);
+  copy.push_back(true);
+  CHECK(copy.capacity() == 256);
+  copy = "101";
+  CHECK(copy.tight_capacity());
+  CHECK(copy.capacity() == 64);
+}
+
+TEST_CASE("bitset keeps appended zeros implicit") {
+  BitSet bs("1011");
+
+  bs <<= 1'000'000;
+  bs.resize(1'000'100);
+  bs.push_back(false);
+  CHECK(bs.size() == 1'000'101);
+  CHECK(bs.implicit_zeros() == 1'000'101 - 64);
+  CHECK(to_string(bs.stored()) == "1011" + std::string(60, '0'));
+
+  CHECK(bs.count() == 3);
+  CHECK(bs.any());
+  CHECK_FALSE(bs.all());
+  CHECK(std::as_const(bs)[3]);
+  CHECK_FALSE(std::as_const(bs)[1'000'000]);
+  CHECK(to_string(bs) == "1011" + std::string(1'000'097, '0'));
+  CHECK(bs == BitSet("1011") << 1'000'097);
+  CHECK(bs != BitSet("10111") << 1'000'096);
+  CHECK(bs < BitSet("10111"));
+  CHECK(bs > BitSet("1011") << 1'000'096);
+  CHECK(BitSet("1") << 3 < BitSet("10000"));
+  CHECK(bs.runs().begin()->length == 1);
+  CHECK(bs.implicit_zeros() == 1'000'101 - 64);
+
+  BitSet copy = bs;
+  CHECK(copy.implicit_zeros() == bs.implicit_zeros());
+  CHECK(copy == bs);
+
+  const BitSet::Word* data = bs.stored().data();
+  bs >>= 1'000'001;
+  CHECK(bs.implicit_zeros() == 36);
+  bs &= BitSet(100, true);
+  CHECK(bs.implicit_zeros() == 36);
+  bs <<= 1'000'001;
+  CHECK(bs.stored().data() == data);
+  CHECK(bs.count() == 3);
+
+  bs.resize(50);
+  CHECK(bs.implicit_zeros() == 0);
+  bs >>= 47;
+  CHECK_THAT(bs, BitSetEqualsString("101"));
+}
+
+TEST_CASE("bitset marks implicit zeros on mutable access only") {
+  BitSet bs("11");
+  bs <<= 100;
+  CHECK(bs.implicit_zeros() == 38);
+
+  SECTION("write") {
+    bs[101] = true;
+    CHECK(bs.implicit_zeros() == 0);
+    CHECK_THAT(bs, BitSetEqualsString("11" + std::string(99, '0') + "1"));
+  }
+
+  SECTION("const view") {
+    BitSet::ConstView view = std::as_const(bs);
+    CHECK(view.size() == 102);
+    CHECK(view.count() == 2);
+    CHECK(std::as_const(bs).begin()[101] == false);
+    CHECK(bs.implicit_zeros() == 38);
+  }
+
+  SECTION("push_back") {
+    bs.push_back(false);
+    CHECK(bs.implicit_zeros() == 39);
+    bs.push_back(true);
+    CHECK(bs.implicit_zeros() == 0);
+    CHECK(bs.count() == 3);
+  }
+
+  SECTION("or") {
+    bs |= BitSet(102, true);
+    CHECK(bs.all());
+  }
+}
+
+TEST_CASE("bitset clears written words when growing back") {
+  std::size_t size = GENERATE(100, 100'000, 10'000'000);
+  CAPTURE(size);
+
+  BitSet bs("11");
+  bs <<= size;
+  bs[size / 2] = true;
+  bs.push_back(true);
+  CHECK(bs.count() == 4);
+
+  bs >>= size + 1;
+  CHECK_THAT(bs, BitSetEqualsString("11"));
+  bs <<= size;
+  CHECK(bs.count() == 2);
+  CHECK_FALSE(std::as_const(bs)[size / 2]);
+
+  bs.reserve(4 * size);
+  bs <<= 2 * size;
+  CHECK(bs.count() == 2);
+  bs.flip();
+  CHECK(bs.count() == 3 * size);
+}
+
+} // namespace ct::test
@@ -0,0 +1,172 @@
+#include "bitset-complement.h"
+#include "test-helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ct::test {
+
+namespace {
+
+std::string flipped_string(std::string str) {
+  for (char& c : str) {
+    c = (c == '0') ? '1' : '0';
+  }
+  return str;
+}
+
+BitSet random_bitset(std::size_t size, std::mt19937_64& rng) {
+  BitSet result(size, false);
+  for (std::size_t i = 0; i < size; ++i) {
+    result[i] = (rng() & 1) != 0;
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("complement bitset flips without touching the words") {
+  ComplementBitSet bits(BitSet("1101100111"));
+  const BitSet::Word* data = bits.view().data();
+  BitSet::Word stored = *data;
+
+  bits.flip();
+  CHECK(bits.complemented());
+  CHECK(*data == stored);
+  CHECK(to_string(bits) == "0010011000");
+  CHECK(bits.count() == 3);
+  CHECK(bits.any());
+  CHECK_FALSE(bits.all());
+  CHECK_FALSE(bits[0]);
+  CHECK(bits[2]);
+  CHECK(bits == BitSet("0010011000"));
+  CHECK(std::vector<bool>(bits.begin(), bits.end()) == string_to_bools("0010011000"));
+
+  bits.set(0);
+  bits.set(2, false);
+  bits.flip(9);
+  CHECK(to_string(bits) == "1000011001");
+  CHECK(bits.complemented());
+
+  CHECK(bits.view() == BitSet("1000011001"));
+  CHECK_FALSE(bits.complemented());
+  CHECK(to_string(~bits) == "0111100110");
+  CHECK(std::vector<bool>((~bits).begin(), (~bits).end()) == string_to_bools("0111100110"));
+  CHECK((~bits).size() == 10);
+}
+
+TEST_CASE("complement bitset answers counts from the stored words") {
+  std::size_t size = GENERATE(0, 1, 64, 100);
+  CAPTURE(size);
+
+  ComplementBitSet zeros(size, false);
+  zeros.flip();
+  CHECK(zeros.count() == size);
+  CHECK(zeros.all());
+  CHECK(zeros.any() == (size != 0));
+
+  ComplementBitSet ones(size, true);
+  ones.flip();
+  CHECK(ones.count() == 0);
+  CHECK_FALSE(ones.any());
+  CHECK(ones.all() == (size == 0));
+
+  ones.set();
+  CHECK_FALSE(ones.complemented());
+  CHECK(ones.count() == size);
+  zeros.reset();
+  CHECK_FALSE(zeros.complemented());
+  CHECK(zeros.count() == 0);
+}
+
+TEST_CASE("complement bitset folds flags into bitwise operations") {
+  std::size_t size = GENERATE(1, 63, 64, 65, 300);
+  bool lhs_flipped = GENERATE(false, true);
+  bool rhs_flipped = GENERATE(false, true);
+  CAPTURE(size, lhs_flipped, rhs_flipped);
+
+  std::mt19937_64 rng(size);
+  BitSet left = random_bitset(size, rng);
+  BitSet right = random_bitset(size + 5, rng);
+  BitSet left_bits = lhs_flipped ? ~left : left;
+  BitSet right_bits = rhs_flipped ? ~right.subview(5) : BitSet(right.subview(5));
+
+  ComplementBitSet rhs(right.subview(5));
+  if (rhs_flipped) {
+    rhs.flip();
+  }
+  auto make_lhs = [&] {
+    ComplementBitSet result(left);
+    if (lhs_flipped) {
+      result.flip();
+    }
+    return result;
+  };
+
+  SECTION("and") {
+    ComplementBitSet lhs = make_lhs();
+    lhs &= rhs;
+    CHECK(lhs.complemented() == lhs_flipped);
+    CHECK(lhs == (left_bits & right_bits));
+  }
+
+  SECTION("or") {
+    ComplementBitSet lhs = make_lhs();
+    lhs |= rhs;
+    CHECK(lhs.complemented() == lhs_flipped);
+    CHECK(lhs == (left_bits | right_bits));
+  }
+
+  SECTION("xor") {
+    ComplementBitSet lhs = make_lhs();
+    lhs ^= rhs;
+    CHECK(lhs == (left_bits ^ right_bits));
+  }
+
+  SECTION("plain views") {
+    ComplementBitSet lhs = make_lhs();
+    lhs &= right.subview(5);
+    lhs |= right.subview(3, size);
+    lhs ^= right.subview(1, size);
+    BitSet expected = ((left_bits & right.subview(5)) | right.subview(3, size)) ^ right.subview(1, size);
+    CHECK(lhs == expected);
+    CHECK(to_string(lhs) == to_string(expected));
+    CHECK(lhs.view() == expected);
+  }
+
+  SECTION("complemented operand") {
+    ComplementBitSet lhs = make_lhs();
+    lhs &= ~rhs;
+    CHECK(lhs == (left_bits & ~right_bits));
+    lhs |= ~rhs;
+    CHECK(lhs == ((left_bits & ~right_bits) | ~right_bits));
+    lhs ^= ~lhs;
+    CHECK(lhs.all());
+    CHECK(rhs.complemented() == rhs_flipped);
+  }
+
+  SECTION("with itself") {
+    ComplementBitSet lhs = make_lhs();
+    lhs &= lhs;
+    CHECK(lhs == left_bits);
+    lhs ^= lhs;
+    CHECK_FALSE(lhs.any());
+  }
+}
+
+TEST_CASE("complement bitset equality") {
+  ComplementBitSet lhs(BitSet("0110"));
+  ComplementBitSet rhs(BitSet("1001"));
+  CHECK_FALSE(lhs == rhs);
+  rhs.flip();
+  CHECK(lhs == rhs);
+  CHECK(flipped_string(to_string(rhs)) == "1001");
+  CHECK_FALSE(lhs == ComplementBitSet(BitSet("01100")));
+  CHECK_FALSE(rhs == BitSet("01100"));
+}
+
+} // namespace ct::test
@@ -5,6 +5,7 @@
 #include <catch2/generators/catch_generators.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
 
+#include <cstdint>
 #include <string>
 
 namespace ct::test {
@@ -169,4 +170,57 @@ TEST_CASE("bitset constructor from view or iterators") {
   }
 }
 
+TEST_CASE("bitset storage alignment") {
+  auto address = [](const BitSet& bs) { return reinterpret_cast<std::uintptr_t>(bs.subview().data()); };
+
+  std::size_t size = GENERATE(1, 100, 1'000);
+  CAPTURE(size);
+  BitSet bs(size, true);
+  CHECK_FALSE(bs.huge_pages());
+  CHECK(address(bs) % BitSet::STORAGE_ALIGNMENT == 0);
+  CHECK(address(BitSet(bs.subview(1))) % BitSet::STORAGE_ALIGNMENT == 0);
+
+  bs <<= 3'000;
+  CHECK(address(bs) % BitSet::STORAGE_ALIGNMENT == 0);
+  CHECK(bs.count() == size);
+}
+
+TEST_CASE("bitset with huge pages") {
+  constexpr std::size_t HUGE_BITS = 8 * BitSet::HUGE_PAGE_BYTES;
+  auto address = [](const BitSet& bs) { return reinterpret_cast<std::uintptr_t>(bs.subview().data()); };
+
+  BitSet small(100, true, HUGE_PAGES);
+  CHECK(small.huge_pages());
+  CHECK(small.count() == 100);
+  CHECK(address(small) % BitSet::STORAGE_ALIGNMENT == 0);
+
+  BitSet bs(HUGE_BITS + 1, false, HUGE_PAGES);
+  CHECK(address(bs) % BitSet::HUGE_PAGE_BYTES == 0);
+  CHECK_FALSE(bs.any());
+  bs[HUGE_BITS] = true;
+
+  BitSet copy = bs;
+  CHECK(copy.huge_pages());
+  CHECK(address(copy) % BitSet::HUGE_PAGE_BYTES == 0);
+  CHECK(copy == bs);
+
+  copy >>= 65;
+  CHECK(copy.huge_pages());
+  CHECK(address(copy) % BitSet::STORAGE_ALIGNMENT == 0);
+  CHECK(copy.count() == 0);
+
+  copy = bs;
+  copy <<= 64;
+  CHECK(address(copy) % BitSet::HUGE_PAGE_BYTES == 0);
+  CHECK(copy.count() == 1);
+
+  copy = bs.subview(1);
+  CHECK(copy.huge_pages());
+  CHECK(address(copy) % BitSet::HUGE_PAGE_BYTES == 0);
+  CHECK(copy == bs.subview(1));
+  small = "101";
+  CHECK(small.huge_pages());
+  CHECK_THAT(small, BitSetEqualsString("101"));
+}
+
 } // namespace ct::test
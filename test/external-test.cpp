@@ -0,0 +1,96 @@
+#include "bitset-layout.h"
+#include "bitset.h"
+#include "test-helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace ct::test {
+
+using detail::Word;
+
+TEST_CASE("view over caller words") {
+  std::vector<Word> words = {0xf000'0000'0000'0001, 0x8000'0000'0000'00ff};
+
+  BitSet::ConstView all{std::span<const Word>(words)};
+  CHECK(all.size() == 128);
+  CHECK(all.count() == 14);
+  CHECK(all[0]);
+  CHECK(all[63]);
+  CHECK(all[64]);
+  CHECK_FALSE(all[65]);
+
+  BitSet::ConstView inner(std::span<const Word>(words), 62, 4);
+  CHECK(to_string(inner) == "0110");
+  CHECK(inner == BitSet("0110"));
+  CHECK(BitSet::ConstView(std::span<const Word>(words), 120) == BitSet("11111111"));
+  CHECK(BitSet::ConstView(std::span<const Word>(words), 200).empty());
+
+  BitSet::View view(std::span<Word>(words), 60, 8);
+  view &= BitSet("10010111");
+  CHECK(words[0] == 0xf000'0000'0000'0001);
+  CHECK(words[1] == 0x0000'0000'0000'00ff);
+  view.flip();
+  CHECK(words[0] == 0xf000'0000'0000'000e);
+  CHECK(words[1] == 0xf000'0000'0000'00ff);
+
+  BitSet copy(all);
+  CHECK(copy == all);
+}
+
+TEST_CASE("view over raw bytes") {
+  alignas(Word) std::array<std::byte, 2 * sizeof(Word)> bytes{};
+  Word first = 0xa000'0000'0000'0003;
+  std::memcpy(bytes.data(), &first, sizeof(Word));
+
+  BitSet::View view{std::span(bytes), std::endian::native, BitOrder::MSB_FIRST};
+  CHECK(view.size() == 128);
+  CHECK(view.count() == 4);
+  CHECK(to_string(view.subview(0, 4)) == "1010");
+
+  view.subview(64, 4).set();
+  BitSet::ConstView readonly(std::span<const std::byte>(bytes), std::endian::native, BitOrder::MSB_FIRST, 60, 8);
+  CHECK(to_string(readonly) == "00111111");
+
+  std::span<std::byte> all(bytes);
+  CHECK_THROWS_AS(BitSet::View(all, std::endian::native, BitOrder::LSB_FIRST), std::invalid_argument);
+  CHECK_THROWS_AS(BitSet::View(all.first(12), std::endian::native, BitOrder::MSB_FIRST), std::invalid_argument);
+  CHECK_THROWS_AS(BitSet::View(all.subspan(4, 8), std::endian::native, BitOrder::MSB_FIRST), std::invalid_argument);
+}
+
+TEST_CASE("conversion of external layouts") {
+  // Bit `i` of both streams is set for `i` in {0, 9, 70}, numbered from the most significant bit of byte 0
+  // and from the least significant one respectively
+  std::array<unsigned char, 16> msb_stream = {0x80, 0x40, 0, 0, 0, 0, 0, 0, 0x02, 0, 0, 0, 0, 0, 0, 0};
+  std::array<unsigned char, 16> lsb_stream = {0x01, 0x02, 0, 0, 0, 0, 0, 0, 0x40, 0, 0, 0, 0, 0, 0, 0};
+  BitSet expected(128, false);
+  expected[0] = true;
+  expected[9] = true;
+  expected[70] = true;
+
+  auto check = [&](const std::array<unsigned char, 16>& stream, std::endian byte_order, BitOrder bit_order) {
+    std::array<Word, 2> words;
+    std::memcpy(words.data(), stream.data(), stream.size());
+    std::array<Word, 2> original = words;
+
+    convert_layout(words, byte_order, bit_order);
+    CHECK(BitSet::ConstView(std::span<const Word>(words)) == expected);
+    convert_layout(words, byte_order, bit_order);
+    CHECK(words == original);
+  };
+
+  check(msb_stream, std::endian::big, BitOrder::MSB_FIRST);
+  check(lsb_stream, std::endian::little, BitOrder::LSB_FIRST);
+
+  static_assert(is_native_layout(std::endian::native, BitOrder::MSB_FIRST));
+  static_assert(!is_native_layout(std::endian::native, BitOrder::LSB_FIRST));
+}
+
+} // namespace ct::test
@@ -0,0 +1,94 @@
+#include "bitset-extract.h"
+#include "test-helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+namespace ct::test {
+
+namespace {
+
+std::string random_string(std::size_t size, double density, std::mt19937_64& rng) {
+  std::string result(size, '0');
+  std::bernoulli_distribution distribution(density);
+  std::ranges::generate(result, [&] { return distribution(rng) ? '1' : '0'; });
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("portable extract and deposit of a word") {
+  using detail::Word;
+  CHECK(detail::extract_word(0b1011'0110, 0b1111'0000) == 0b1011);
+  CHECK(detail::extract_word(0b1011'0110, 0b0101'0101) == 0b0110);
+  CHECK(detail::extract_word(~Word(0), 0) == 0);
+  CHECK(detail::extract_word(0x0123'4567'89ab'cdef, ~Word(0)) == 0x0123'4567'89ab'cdef);
+  CHECK(detail::deposit_word(0b1011, 0b1111'0000) == 0b1011'0000);
+  CHECK(detail::deposit_word(0b0110, 0b0101'0101) == 0b0001'0100);
+  CHECK(detail::deposit_word(~Word(0), Word(1) << 63) == Word(1) << 63);
+
+  std::mt19937_64 rng(1);
+  for (std::size_t i = 0; i < 1'000; ++i) {
+    Word value = rng();
+    Word mask = rng() & rng();
+    CHECK(detail::deposit_word(detail::extract_word(value, mask), mask) == (value & mask));
+  }
+}
+
+TEST_CASE("extract and deposit") {
+  BitSet src("1101100111");
+  BitSet mask("0110010011");
+
+  CHECK_THAT(extract(src, mask), BitSetEqualsString("10011"));
+  CHECK_THAT(extract(src, BitSet(10, false)), BitSetEqualsString(""));
+  CHECK(extract(src, BitSet(10, true)) == src);
+
+  BitSet dst("1010101010");
+  deposit(BitSet("01101"), mask, dst);
+  CHECK_THAT(dst, BitSetEqualsString("1010111001"));
+}
+
+TEST_CASE("extract and deposit of misaligned views") {
+  auto [src_offset, mask_offset, dst_offset] = GENERATE(table<std::size_t, std::size_t, std::size_t>({
+      {0, 0, 0},
+      {3, 0, 64},
+      {0, 17, 1},
+      {63, 5, 0},
+      {64, 64, 64},
+      {29, 41, 7},
+  }));
+  std::size_t size = GENERATE(1, 63, 64, 65, 200, 4'099);
+  double density = GENERATE(0.02, 0.5, 0.98);
+  CAPTURE(src_offset, mask_offset, dst_offset, size, density);
+
+  std::mt19937_64 rng(src_offset * 31 + mask_offset * 7 + size);
+  std::string src_str = random_string(src_offset + size + 70, 0.5, rng);
+  std::string mask_str = random_string(mask_offset + size + 70, density, rng);
+  std::string dst_str = random_string(dst_offset + size + 70, 0.5, rng);
+  BitSet src(src_str);
+  BitSet mask(mask_str);
+  BitSet dst(dst_str);
+
+  std::string selected;
+  for (std::size_t i = 0; i < size; ++i) {
+    if (mask_str[mask_offset + i] == '1') {
+      selected += src_str[src_offset + i];
+    }
+  }
+  CHECK_THAT(extract(src.subview(src_offset, size), mask.subview(mask_offset, size)), BitSetEqualsString(selected));
+
+  std::size_t next = src_offset;
+  for (std::size_t i = 0; i < size; ++i) {
+    if (mask_str[mask_offset + i] == '1') {
+      dst_str[dst_offset + i] = src_str[next++];
+    }
+  }
+  deposit(src.subview(src_offset, size), mask.subview(mask_offset, size), dst.subview(dst_offset, size));
+  CHECK_THAT(dst, BitSetEqualsString(dst_str));
+}
+
+} // namespace ct::test
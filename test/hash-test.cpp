@@ -0,0 +1,64 @@
+#include "bitset.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <functional>
+#include <string>
+#include <unordered_set>
+
+namespace ct::test {
+
+TEST_CASE("equal bitsets have equal hashes") {
+  std::string str = GENERATE(
+      "",
+      "0",
+      "1101101",
+      "11110110111010000100101111101000011011111111000001100110010010001011100100110101"
+  );
+  CAPTURE(str);
+
+  const BitSet bs_1(str);
+  const BitSet bs_2(str);
+
+  CHECK(std::hash<BitSet>()(bs_1) == std::hash<BitSet>()(bs_2));
+  CHECK(std::hash<BitSet::ConstView>()(bs_1) == std::hash<BitSet>()(bs_1));
+}
+
+TEST_CASE("hash does not depend on view alignment") {
+  std::string str = "11110110111010000100101111101000011011111111000001100110010010001011100100110101";
+  std::size_t offset = GENERATE(0, 1, 7, 63, 64, 65, 100);
+  std::size_t count = GENERATE(0, 1, 20, 64, 80, 129);
+  CAPTURE(offset, count);
+
+  std::string sub = (str + str).substr(0, count);
+  const BitSet bs(sub);
+  BitSet source(std::string(offset, '1') + sub + "0110");
+  BitSet::View view = source.subview(offset, count);
+
+  REQUIRE(view == bs);
+  CHECK(std::hash<BitSet::View>()(view) == std::hash<BitSet>()(bs));
+  CHECK(std::hash<BitSet::ConstView>()(std::as_const(source).subview(offset, count)) == std::hash<BitSet>()(bs));
+}
+
+TEST_CASE("hash distinguishes sizes and contents") {
+  CHECK(std::hash<BitSet>()(BitSet("")) != std::hash<BitSet>()(BitSet("0")));
+  CHECK(std::hash<BitSet>()(BitSet("0")) != std::hash<BitSet>()(BitSet("00")));
+  CHECK(std::hash<BitSet>()(BitSet("0")) != std::hash<BitSet>()(BitSet("1")));
+  CHECK(std::hash<BitSet>()(BitSet(130, false)) != std::hash<BitSet>()(BitSet(129, false)));
+}
+
+TEST_CASE("heterogeneous lookup by view") {
+  std::unordered_set<BitSet, BitSetHash, std::equal_to<>> set;
+  set.emplace("1101101");
+  set.emplace("0110");
+  set.emplace("11110110111010000100101111101000011011111111000001100110010010001011100100110101");
+
+  const BitSet source("0011011010110");
+  CHECK(set.contains(source.subview(2, 7)));
+  CHECK(set.contains(source.subview(9, 4)));
+  CHECK_FALSE(set.contains(source.subview(2, 6)));
+  CHECK(set.find(source.subview(2, 7)) == set.find(BitSet("1101101")));
+}
+
+} // namespace ct::test
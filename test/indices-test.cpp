@@ -0,0 +1,99 @@
+#include "bitset.h"
+#include "test-helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace ct::test {
+
+namespace {
+
+std::vector<std::uint64_t> string_to_indices(std::string_view str) {
+  std::vector<std::uint64_t> result;
+  for (std::size_t i = 0; i < str.size(); ++i) {
+    if (str[i] == '1') {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("bitset from indices") {
+  std::string_view str = GENERATE(
+      "",
+      "0000000",
+      "1101101",
+      "11110110111010000100101111101000011011111111000001100110010010001011100100110101"
+  );
+  CAPTURE(str);
+
+  std::vector<std::uint64_t> indices = string_to_indices(str);
+  std::vector<std::uint32_t> narrow(indices.begin(), indices.end());
+
+  CHECK_THAT(BitSet::from_indices(indices, str.size()), BitSetEqualsString(str));
+  CHECK_THAT(BitSet::from_indices(narrow, str.size()), BitSetEqualsString(str));
+}
+
+TEST_CASE("bitset to indices") {
+  std::string_view str = GENERATE(
+      "",
+      "0000000",
+      "1101101",
+      "11110110111010000100101111101000011011111111000001100110010010001011100100110101"
+  );
+  CAPTURE(str);
+  const BitSet bs(str);
+  std::vector<std::uint64_t> expected = string_to_indices(str);
+
+  std::vector<std::uint64_t> wide = {42};
+  bs.append_indices(wide);
+  CHECK(std::vector(wide.begin() + 1, wide.end()) == expected);
+
+  std::vector<std::uint32_t> narrow;
+  bs.append_indices(narrow);
+  CHECK(std::vector<std::uint64_t>(narrow.begin(), narrow.end()) == expected);
+
+  std::vector<std::uint32_t> truncated(expected.size() / 2);
+  CHECK(bs.to_indices(truncated) == truncated.size());
+  CHECK(std::vector<std::uint64_t>(truncated.begin(), truncated.end()) ==
+        std::vector(expected.begin(), expected.begin() + static_cast<std::ptrdiff_t>(truncated.size())));
+}
+
+TEST_CASE("indices of subviews") {
+  std::string str = "11110110111010000100101111101000011011111111000001100110010010001011100100110101";
+  std::size_t offset = GENERATE(0, 1, 13, 64);
+  std::size_t count = GENERATE(0, 5, 15, 66);
+  CAPTURE(offset, count);
+
+  BitSet bs(str);
+  std::string_view sub = std::string_view(str).substr(offset, count);
+  std::vector<std::uint64_t> expected = string_to_indices(sub);
+
+  std::vector<std::uint64_t> actual;
+  std::as_const(bs).subview(offset, count).append_indices(actual);
+  CHECK(actual == expected);
+
+  std::vector<std::uint64_t> truncated(expected.size() / 2);
+  CHECK(std::as_const(bs).subview(offset, count).to_indices(truncated) == truncated.size());
+  CHECK(truncated ==
+        std::vector(expected.begin(), expected.begin() + static_cast<std::ptrdiff_t>(truncated.size())));
+
+  std::vector<std::uint32_t> flipped;
+  for (std::size_t i = 0; i < sub.size(); ++i) {
+    if (sub[i] == '0') {
+      flipped.push_back(static_cast<std::uint32_t>(i));
+    }
+  }
+  bs.subview(offset, count).assign_indices(flipped);
+  for (std::size_t i = offset; i < offset + sub.size(); ++i) {
+    str[i] = (str[i] == '1') ? '0' : '1';
+  }
+  CHECK_THAT(bs, BitSetEqualsString(str));
+}
+
+} // namespace ct::test
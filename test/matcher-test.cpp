@@ -0,0 +1,130 @@
+#include "bitset-matcher.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ct::test {
+
+namespace {
+
+std::string random_text(std::size_t size, std::mt19937_64& rng) {
+  std::string result(size, 'a');
+  std::uniform_int_distribution<int> distribution(0, 2);
+  std::ranges::generate(result, [&] { return static_cast<char>('a' + distribution(rng)); });
+  return result;
+}
+
+std::vector<Match> naive_mismatches(std::string_view pattern, std::string_view text, std::size_t max_mismatches) {
+  std::vector<Match> result;
+  for (std::size_t end = std::max<std::size_t>(pattern.size(), 1); end <= text.size(); ++end) {
+    std::size_t start = end - pattern.size();
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+      mismatches += (pattern[i] != text[start + i]);
+    }
+    if (mismatches <= max_mismatches) {
+      result.push_back({end, mismatches});
+    }
+  }
+  return result;
+}
+
+// Smallest edit distance between the pattern and a substring of the text ending at each position
+std::vector<Match> naive_edits(std::string_view pattern, std::string_view text, std::size_t max_distance) {
+  std::vector<Match> result;
+  std::vector<std::size_t> column(pattern.size() + 1);
+  std::iota(column.begin(), column.end(), std::size_t(0));
+  for (std::size_t end = 1; end <= text.size(); ++end) {
+    std::size_t diagonal = column[0];
+    for (std::size_t i = 1; i <= pattern.size(); ++i) {
+      std::size_t substitution = diagonal + (pattern[i - 1] != text[end - 1]);
+      diagonal = column[i];
+      column[i] = std::min({substitution, column[i] + 1, column[i - 1] + 1});
+    }
+    if (column.back() <= max_distance) {
+      result.push_back({end, column.back()});
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("exact shift-or matching") {
+  ShiftOrMatcher matcher("aba");
+  std::vector<Match> matches;
+  matcher.feed("abababa", matches);
+  CHECK(matches == std::vector<Match>{{3, 0}, {5, 0}, {7, 0}});
+  CHECK(matcher.position() == 7);
+
+  matches.clear();
+  matcher.feed("ba", matches);
+  CHECK(matches == std::vector<Match>{{9, 0}});
+
+  matcher.reset();
+  matches.clear();
+  matcher.feed("ba", matches);
+  CHECK(matches.empty());
+  CHECK(matcher.position() == 2);
+}
+
+TEST_CASE("myers matching") {
+  MyersMatcher matcher("survey", 2);
+  std::vector<Match> matches;
+  matcher.feed("surgery", matches);
+  CHECK(matches == naive_edits("survey", "surgery", 2));
+  CHECK(std::ranges::find(matches, Match{6, 2}) != matches.end());
+}
+
+TEST_CASE("matchers agree with naive search") {
+  std::size_t length = GENERATE(0, 1, 5, 63, 64, 65, 130, 200);
+  std::size_t errors = GENERATE(0, 1, 3, 20);
+  CAPTURE(length, errors);
+
+  std::mt19937_64 rng(length * 100 + errors);
+  std::string text = random_text(2'000, rng);
+  // Plant slightly damaged copies of the pattern so that long patterns occur too
+  std::string pattern = random_text(length, rng);
+  for (std::size_t start = 100; start + length < text.size(); start += 700) {
+    text.replace(start, length, pattern);
+    if (length != 0) {
+      text[start + length / 2] = 'c';
+    }
+  }
+
+  SECTION("shift-or") {
+    ShiftOrMatcher matcher(pattern, errors);
+    std::vector<Match> matches;
+    matcher.feed(text, matches);
+    CHECK(matches == naive_mismatches(pattern, text, errors));
+  }
+
+  SECTION("myers") {
+    MyersMatcher matcher(pattern, errors);
+    std::vector<Match> matches;
+    matcher.feed(text, matches);
+    CHECK(matches == naive_edits(pattern, text, errors));
+  }
+
+  SECTION("streaming") {
+    ShiftOrMatcher shift_or(pattern, errors);
+    MyersMatcher myers(pattern, errors);
+    std::vector<Match> shift_or_matches;
+    std::vector<Match> myers_matches;
+    for (std::size_t start = 0; start < text.size(); start += 333) {
+      std::string_view chunk = std::string_view(text).substr(start, 333);
+      shift_or.feed(chunk, shift_or_matches);
+      myers.feed(chunk, myers_matches);
+    }
+    CHECK(shift_or_matches == naive_mismatches(pattern, text, errors));
+    CHECK(myers_matches == naive_edits(pattern, text, errors));
+  }
+}
+
+} // namespace ct::test
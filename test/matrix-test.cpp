@@ -0,0 +1,218 @@
+#include "bitset-matrix.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace ct::test {
+
+namespace {
+
+using Bools = std::vector<std::vector<bool>>;
+
+BitMatrix random_matrix(std::size_t rows, std::size_t columns, std::mt19937_64& rng) {
+  BitMatrix result(rows, columns, false);
+  std::bernoulli_distribution distribution;
+  for (std::size_t i = 0; i < rows; ++i) {
+    for (std::size_t j = 0; j < columns; ++j) {
+      result[i][j] = distribution(rng);
+    }
+  }
+  return result;
+}
+
+Bools to_bools(const BitMatrix& matrix) {
+  Bools result(matrix.rows(), std::vector<bool>(matrix.columns()));
+  for (std::size_t i = 0; i < matrix.rows(); ++i) {
+    for (std::size_t j = 0; j < matrix.columns(); ++j) {
+      result[i][j] = matrix[i][j];
+    }
+  }
+  return result;
+}
+
+Bools naive_product(const Bools& left, const Bools& right, std::size_t columns, bool boolean) {
+  Bools result(left.size(), std::vector<bool>(columns));
+  for (std::size_t i = 0; i < left.size(); ++i) {
+    for (std::size_t j = 0; j < columns; ++j) {
+      bool value = false;
+      for (std::size_t k = 0; k < right.size(); ++k) {
+        bool term = left[i][k] && right[k][j];
+        value = boolean ? (value || term) : (value != term);
+      }
+      result[i][j] = value;
+    }
+  }
+  return result;
+}
+
+std::size_t naive_rank(Bools rows) {
+  std::size_t rank = 0;
+  std::size_t columns = rows.empty() ? 0 : rows[0].size();
+  for (std::size_t column = 0; column < columns && rank < rows.size(); ++column) {
+    std::size_t pivot = rank;
+    while (pivot < rows.size() && !rows[pivot][column]) {
+      ++pivot;
+    }
+    if (pivot == rows.size()) {
+      continue;
+    }
+    std::swap(rows[pivot], rows[rank]);
+    for (std::size_t row = rank + 1; row < rows.size(); ++row) {
+      if (rows[row][column]) {
+        for (std::size_t j = column; j < columns; ++j) {
+          rows[row][j] = rows[row][j] != rows[rank][j];
+        }
+      }
+    }
+    ++rank;
+  }
+  return rank;
+}
+
+} // namespace
+
+TEST_CASE("matrix construction") {
+  BitMatrix empty;
+  CHECK(empty.rows() == 0);
+  CHECK(empty.columns() == 0);
+
+  BitMatrix ones(3, 70, true);
+  CHECK(ones.rows() == 3);
+  CHECK(ones.columns() == 70);
+  for (std::size_t i = 0; i < ones.rows(); ++i) {
+    CHECK(ones[i].size() == 70);
+    CHECK(ones[i].all());
+  }
+
+  BitMatrix identity = BitMatrix::identity(5);
+  for (std::size_t i = 0; i < 5; ++i) {
+    for (std::size_t j = 0; j < 5; ++j) {
+      CHECK(identity[i][j] == (i == j));
+    }
+  }
+
+  BitMatrix copy = ones;
+  copy[1][69] = false;
+  CHECK(ones[1][69]);
+  CHECK(copy != ones);
+  copy = ones;
+  CHECK(copy == ones);
+}
+
+TEST_CASE("matrix rows are views") {
+  BitMatrix matrix(2, 100, false);
+  matrix[1].subview(10, 60).set();
+  CHECK(matrix[0].count() == 0);
+  CHECK(matrix[1].count() == 60);
+  CHECK(matrix[1][9] == false);
+  CHECK(matrix[1][10] == true);
+  CHECK(matrix[1][69] == true);
+  CHECK(matrix[1][70] == false);
+}
+
+TEST_CASE("matrix transpose") {
+  auto [rows, columns] = GENERATE(
+      std::pair<std::size_t, std::size_t>(0, 5),
+      std::pair<std::size_t, std::size_t>(1, 1),
+      std::pair<std::size_t, std::size_t>(3, 64),
+      std::pair<std::size_t, std::size_t>(64, 64),
+      std::pair<std::size_t, std::size_t>(65, 130),
+      std::pair<std::size_t, std::size_t>(200, 7)
+  );
+  CAPTURE(rows, columns);
+  std::mt19937_64 rng(rows * 1000 + columns);
+  BitMatrix matrix = random_matrix(rows, columns, rng);
+
+  BitMatrix transposed = matrix.transposed();
+  REQUIRE(transposed.rows() == columns);
+  REQUIRE(transposed.columns() == rows);
+  for (std::size_t i = 0; i < rows; ++i) {
+    for (std::size_t j = 0; j < columns; ++j) {
+      CHECK(transposed[j][i] == matrix[i][j]);
+    }
+  }
+  CHECK(transposed.transposed() == matrix);
+}
+
+TEST_CASE("matrix multiplication") {
+  auto [n, m, p] = GENERATE(
+      std::tuple<std::size_t, std::size_t, std::size_t>(1, 1, 1),
+      std::tuple<std::size_t, std::size_t, std::size_t>(3, 5, 7),
+      std::tuple<std::size_t, std::size_t, std::size_t>(20, 64, 65),
+      std::tuple<std::size_t, std::size_t, std::size_t>(70, 131, 1100)
+  );
+  CAPTURE(n, m, p);
+  std::mt19937_64 rng(n + m + p);
+  BitMatrix left = random_matrix(n, m, rng);
+  BitMatrix right = random_matrix(m, p, rng);
+
+  CHECK(to_bools(left * right) == naive_product(to_bools(left), to_bools(right), p, false));
+  CHECK(to_bools(boolean_multiply(left, right)) == naive_product(to_bools(left), to_bools(right), p, true));
+  CHECK(BitMatrix::identity(n) * left == left);
+  CHECK(left * BitMatrix::identity(m) == left);
+}
+
+TEST_CASE("matrix multiplication checks dimensions") {
+  BitMatrix left(3, 5, true);
+  BitMatrix right(4, 7, true);
+
+  CHECK_THROWS_AS(left * right, std::invalid_argument);
+  CHECK_THROWS_AS(boolean_multiply(left, right), std::invalid_argument);
+  CHECK_THROWS_AS(left * left, std::invalid_argument);
+  CHECK_NOTHROW(left * left.transposed());
+}
+
+TEST_CASE("matrix elimination") {
+  auto [rows, columns] = GENERATE(
+      std::pair<std::size_t, std::size_t>(0, 0),
+      std::pair<std::size_t, std::size_t>(1, 1),
+      std::pair<std::size_t, std::size_t>(10, 3),
+      std::pair<std::size_t, std::size_t>(64, 64),
+      std::pair<std::size_t, std::size_t>(70, 150),
+      std::pair<std::size_t, std::size_t>(150, 70)
+  );
+  CAPTURE(rows, columns);
+  std::mt19937_64 rng(rows * 1000 + columns);
+  BitMatrix matrix = random_matrix(rows, columns, rng);
+  // A duplicated row makes the matrix rank-deficient
+  if (rows > 2) {
+    matrix[rows - 1].reset();
+    matrix[rows - 1] |= matrix[0];
+  }
+
+  std::size_t expected = naive_rank(to_bools(matrix));
+  CHECK(matrix.rank() == expected);
+  CHECK(matrix.transposed().rank() == expected);
+
+  BitMatrix reduced = matrix;
+  REQUIRE(reduced.eliminate() == expected);
+  std::size_t previous = 0;
+  for (std::size_t i = 0; i < rows; ++i) {
+    CAPTURE(i);
+    BitMatrix::ConstView row = reduced[i];
+    auto pivot = static_cast<std::size_t>(std::find(row.begin(), row.end(), true) - row.begin());
+    if (i >= expected) {
+      CHECK(pivot == columns);
+      continue;
+    }
+    CHECK((i == 0 || pivot > previous));
+    for (std::size_t j = 0; j < rows; ++j) {
+      CHECK(reduced[j][pivot] == (i == j));
+    }
+    previous = pivot;
+  }
+
+  CHECK(BitMatrix::identity(17).rank() == 17);
+  CHECK(BitMatrix(5, 9, false).rank() == 0);
+  CHECK(BitMatrix(5, 9, true).rank() == 1);
+}
+
+} // namespace ct::test
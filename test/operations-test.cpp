@@ -7,7 +7,11 @@
 
 #include <algorithm>
 #include <array>
+#include <compare>
+#include <set>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace ct::test {
 
@@ -580,6 +584,84 @@ TEST_CASE("bitset comparison") {
   }
 }
 
+TEST_CASE("bitset ordering") {
+  SECTION("single word") {
+    std::array strings = {"", "0", "1", "10110", "10111", "101101", "101110"};
+    std::string_view str_1 = GENERATE_REF(from_range(strings));
+    std::string_view str_2 = GENERATE_REF(from_range(strings));
+    CAPTURE(str_1, str_2);
+
+    const BitSet bs_1(str_1);
+    const BitSet bs_2(str_2);
+
+    CHECK((bs_1 <=> bs_2) == (str_1 <=> str_2));
+  }
+
+  SECTION("multiple words") {
+    std::array strings = {
+        "1111011011101000010010111110100001101111111100000110011001001",
+        "11110110111010000100101111101000011011111111000001100110010010001011100100110101",
+        "11110110111010000100101111101000011011111111000001100110010010000000000000000000",
+        "11110110111010000100101111101000011011111111000001100110010010000000000000000000000",
+        "11110110111010000100101111101000011011111111000001101110010010000000000000000000",
+    };
+    std::string_view str_1 = GENERATE_REF(from_range(strings));
+    std::string_view str_2 = GENERATE_REF(from_range(strings));
+    CAPTURE(str_1, str_2);
+
+    const BitSet bs_1(str_1);
+    const BitSet bs_2(str_2);
+
+    CHECK((bs_1 <=> bs_2) == (str_1 <=> str_2));
+  }
+}
+
+TEST_CASE("misaligned view comparison") {
+  std::string str = "10101101001101100100101110111000001010101110101010100000100101001101010001101011";
+  const BitSet bs(str);
+  std::size_t offset = GENERATE(0, 1, 3, 17, 63, 64, 65);
+  std::size_t count = GENERATE(0, 1, 10, 64, 70);
+  CAPTURE(offset, count);
+
+  std::string prefix = "01" + str.substr(0, offset);
+  const BitSet shifted(prefix + str + "110");
+  BitSet::ConstView view = shifted.subview(prefix.size(), str.size());
+  REQUIRE(view == bs);
+
+  std::string_view expected = std::string_view(str).substr(offset, count);
+  BitSet::ConstView lhs = view.subview(offset, count);
+  BitSet::ConstView rhs = bs.subview(offset, count);
+  CHECK(lhs == rhs);
+  CHECK((lhs <=> rhs) == std::strong_ordering::equal);
+  CHECK(lhs == BitSet(expected));
+
+  if (!expected.empty()) {
+    BitSet changed(expected);
+    changed[expected.size() - 1].flip();
+    CHECK(lhs != changed);
+    CHECK((lhs < changed) == (expected < to_string(changed)));
+    CHECK((changed < lhs) == (to_string(changed) < expected));
+  }
+}
+
+TEST_CASE("bitsets are usable as ordered keys") {
+  std::array strings = {"101", "1", "", "0110", "10", "0", "1010"};
+  std::set<BitSet> set;
+  for (std::string_view str : strings) {
+    set.emplace(str);
+  }
+
+  std::vector<std::string> sorted(strings.begin(), strings.end());
+  std::ranges::sort(sorted);
+
+  REQUIRE(set.size() == sorted.size());
+  for (std::size_t i = 0; const BitSet& bs : set) {
+    CAPTURE(i);
+    CHECK(to_string(bs) == sorted[i]);
+    ++i;
+  }
+}
+
 TEST_CASE("view operations") {
   BitSet bs("1110010101");
 
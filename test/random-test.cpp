@@ -0,0 +1,81 @@
+#include "bitset-random.h"
+#include "test-helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace ct::test {
+
+TEST_CASE("bulk generation matches single calls") {
+  Xoshiro256x4 bulk(5);
+  Xoshiro256x4 single(5);
+  std::vector<std::uint64_t> words(13);
+  for (std::size_t start : {0, 1, 3}) {
+    for (std::size_t i = 0; i < start; ++i) {
+      CHECK(bulk() == single());
+    }
+    bulk.generate(words);
+    for (std::uint64_t word : words) {
+      CHECK(word == single());
+    }
+  }
+}
+
+TEST_CASE("random fill is reproducible") {
+  BitSet first(10'000, false);
+  BitSet second(10'000, false);
+  Xoshiro256x4 rng(42);
+  Xoshiro256x4 same(42);
+  Xoshiro256x4 other(43);
+
+  fill_random(first, rng, 0.3);
+  fill_random(second, same, 0.3);
+  CHECK(first == second);
+
+  fill_random(second, other, 0.3);
+  CHECK(first != second);
+}
+
+TEST_CASE("random fill density") {
+  double p = GENERATE(0.5, 0.25, 0.1, 0.9, 0.01, 0.999, 1.0 / 3);
+  CAPTURE(p);
+  constexpr std::size_t SIZE = 1 << 20;
+
+  BitSet bits(SIZE, false);
+  Xoshiro256x4 rng(7);
+  fill_random(bits, rng, p);
+
+  double expected = p * SIZE;
+  double deviation = std::sqrt(SIZE * p * (1 - p));
+  CHECK(std::abs(static_cast<double>(bits.count()) - expected) < 5 * deviation);
+
+  // Neighbouring bits must be independent as well
+  BitSet pairs = bits & (bits << 1).subview(1);
+  double expected_pairs = p * p * (SIZE - 1);
+  CHECK(std::abs(static_cast<double>(pairs.count()) - expected_pairs) < 5 * std::sqrt(expected_pairs) + 1);
+}
+
+TEST_CASE("random fill of a misaligned view") {
+  BitSet bits(300, false);
+  std::mt19937 rng(1);
+
+  fill_random(bits.subview(5, 200), rng, 1.0);
+  CHECK_FALSE(bits.subview(0, 5).any());
+  CHECK(bits.subview(5, 200).all());
+  CHECK_FALSE(bits.subview(205).any());
+
+  fill_random(bits.subview(3, 290), rng, 0.5);
+  CHECK_FALSE(bits.subview(0, 3).any());
+  CHECK_FALSE(bits.subview(293).any());
+  CHECK(bits.subview(3, 290).any());
+  CHECK_FALSE(bits.subview(3, 290).all());
+
+  fill_random(bits.subview(1), rng, 0.0);
+  CHECK_FALSE(bits.any());
+}
+
+} // namespace ct::test
@@ -0,0 +1,94 @@
+#include "bitset-reduce.h"
+#include "test-helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ct::test {
+
+TEST_CASE("reductions of a few bitsets") {
+  const BitSet a("1101100111");
+  const BitSet b("1011101101");
+  const BitSet c("0111001100");
+  std::vector<BitSet::ConstView> views = {a, b, c};
+
+  CHECK_THAT(and_all(views), BitSetEqualsString("0001000100"));
+  CHECK_THAT(or_all(views), BitSetEqualsString("1111101111"));
+  CHECK_THAT(xor_all(views), BitSetEqualsString("0001000110"));
+  CHECK_THAT(threshold_count(views, 0), BitSetEqualsString("1111111111"));
+  CHECK_THAT(threshold_count(views, 1), BitSetEqualsString("1111101111"));
+  CHECK_THAT(threshold_count(views, 2), BitSetEqualsString("1111101101"));
+  CHECK_THAT(threshold_count(views, 3), BitSetEqualsString("0001000100"));
+  CHECK_THAT(threshold_count(views, 4), BitSetEqualsString("0000000000"));
+
+  CHECK(count_and_all(views) == 2);
+  CHECK(count_or_all(views) == 9);
+  CHECK(count_xor_all(views) == 3);
+  CHECK(count_threshold(views, 0) == 10);
+  CHECK(count_threshold(views, 2) == 8);
+  CHECK(count_threshold(views, 4) == 0);
+
+  CHECK(and_all({}).empty());
+  CHECK(count_or_all({}) == 0);
+  CHECK(threshold_count({}, 1).empty());
+}
+
+TEST_CASE("reductions match per-bit computation") {
+  std::size_t inputs = GENERATE(1, 2, 7, 64, 100);
+  std::size_t size = GENERATE(1, 64, 200, 20'000);
+  double density = GENERATE(0.1, 0.5, 0.99);
+  bool aligned = GENERATE(false, true);
+  CAPTURE(inputs, size, density, aligned);
+
+  std::mt19937_64 rng(inputs * size);
+  std::bernoulli_distribution distribution(density);
+  std::uniform_int_distribution<std::size_t> offsets(0, 100);
+  std::vector<BitSet> storage;
+  std::vector<BitSet::ConstView> views;
+  storage.reserve(inputs);
+  for (std::size_t i = 0; i < inputs; ++i) {
+    std::size_t offset = (aligned || i % 3 == 0) ? 0 : offsets(rng);
+    BitSet& bs = storage.emplace_back(offset + size, false);
+    for (std::size_t j = 0; j < size; ++j) {
+      bs[offset + j] = distribution(rng);
+    }
+    views.push_back(bs.subview(offset));
+  }
+
+  std::vector<std::size_t> counts(size);
+  std::string expected_xor(size, '0');
+  for (const BitSet::ConstView& view : views) {
+    for (std::size_t j = 0; j < size; ++j) {
+      counts[j] += view[j];
+      expected_xor[j] = (counts[j] % 2 == 1) ? '1' : '0';
+    }
+  }
+  auto at_least = [&](std::size_t threshold) {
+    std::string result(size, '0');
+    for (std::size_t j = 0; j < size; ++j) {
+      result[j] = (counts[j] >= threshold) ? '1' : '0';
+    }
+    return result;
+  };
+
+  CHECK_THAT(and_all(views), BitSetEqualsString(at_least(inputs)));
+  CHECK_THAT(or_all(views), BitSetEqualsString(at_least(1)));
+  CHECK_THAT(xor_all(views), BitSetEqualsString(expected_xor));
+  CHECK(count_and_all(views) == and_all(views).count());
+  CHECK(count_or_all(views) == or_all(views).count());
+  CHECK(count_xor_all(views) == xor_all(views).count());
+
+  for (std::size_t threshold : {inputs / 2, inputs / 3 + 1, inputs - 1}) {
+    CAPTURE(threshold);
+    std::string expected = at_least(threshold);
+    CHECK_THAT(threshold_count(views, threshold), BitSetEqualsString(expected));
+    CHECK(count_threshold(views, threshold) == static_cast<std::size_t>(std::ranges::count(expected, '1')));
+  }
+}
+
+} // namespace ct::test
@@ -0,0 +1,144 @@
+#include "bitset-reversed.h"
+#include "bitset.h"
+#include "test-helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+namespace ct::test {
+
+namespace {
+
+std::string random_string(std::size_t size, std::mt19937_64& rng) {
+  std::string result(size, '0');
+  std::bernoulli_distribution distribution;
+  std::ranges::generate(result, [&] { return distribution(rng) ? '1' : '0'; });
+  return result;
+}
+
+std::string reversed_string(std::string str) {
+  std::ranges::reverse(str);
+  return str;
+}
+
+} // namespace
+
+TEST_CASE("reverse a word") {
+  using detail::Word;
+  static_assert(detail::reverse_word(0) == 0);
+  static_assert(detail::reverse_word(1) == Word(1) << 63);
+  static_assert(detail::reverse_word(0x0123'4567'89ab'cdef) == 0xf7b3'd591'e6a2'c480);
+  static_assert(detail::reverse_word(detail::reverse_word(0xdead'beef'0bad'f00d)) == 0xdead'beef'0bad'f00d);
+}
+
+TEST_CASE("reverse a bitset") {
+  std::string_view str = GENERATE(
+      "",
+      "1",
+      "10",
+      "1101100111",
+      "11110110111010000100101111101000011011111111000001100110010010001011100100110101"
+  );
+  CAPTURE(str);
+  BitSet bs(str);
+  std::string expected = reversed_string(std::string(str));
+
+  CHECK_THAT(reversed(bs), BitSetEqualsString(expected));
+  bs.reverse();
+  CHECK_THAT(bs, BitSetEqualsString(expected));
+}
+
+TEST_CASE("reverse misaligned views") {
+  auto [offset, size] = GENERATE(table<std::size_t, std::size_t>({
+      {0, 1},
+      {3, 60},
+      {5, 64},
+      {64, 128},
+      {0, 129},
+      {7, 300},
+      {13, 10'000},
+  }));
+  CAPTURE(offset, size);
+
+  std::mt19937_64 rng(offset * 31 + size);
+  std::string str = random_string(offset + size + 70, rng);
+  BitSet bs(str);
+  std::string inner = reversed_string(str.substr(offset, size));
+
+  CHECK_THAT(reversed(bs.subview(offset, size)), BitSetEqualsString(inner));
+
+  bs.subview(offset, size).reverse();
+  str.replace(offset, size, inner);
+  CHECK_THAT(bs, BitSetEqualsString(str));
+}
+
+TEST_CASE("reversed view") {
+  auto [offset, size] = GENERATE(table<std::size_t, std::size_t>({
+      {0, 0},
+      {0, 10},
+      {3, 64},
+      {17, 200},
+      {64, 1'000},
+  }));
+  CAPTURE(offset, size);
+
+  std::mt19937_64 rng(offset * 7 + size);
+  std::string base_str = random_string(offset + size + 10, rng);
+  std::string target_str = random_string(size + 5, rng);
+  BitSet base(base_str);
+  BitSet target(target_str);
+  std::string inner = reversed_string(base_str.substr(offset, size));
+  ReversedConstView view(base.subview(offset, size));
+
+  CHECK(view.size() == size);
+  CHECK(view.count() == static_cast<std::size_t>(std::ranges::count(inner, '1')));
+  for (std::size_t i = 0; i < size; ++i) {
+    CHECK(view[i] == (inner[i] == '1'));
+  }
+  CHECK(view == BitSet(inner));
+  CHECK(BitSet(inner) == view);
+  CHECK(view == ReversedConstView(base.subview(offset, size)));
+  if (size != 0) {
+    BitSet other(inner);
+    other[size / 2].flip();
+    CHECK(view != other);
+  }
+
+  std::string expected = target_str;
+  SECTION("and") {
+    target.subview(5) &= view;
+    for (std::size_t i = 0; i < size; ++i) {
+      expected[5 + i] = (expected[5 + i] == '1' && inner[i] == '1') ? '1' : '0';
+    }
+  }
+  SECTION("or") {
+    target.subview(5) |= view;
+    for (std::size_t i = 0; i < size; ++i) {
+      expected[5 + i] = (expected[5 + i] == '1' || inner[i] == '1') ? '1' : '0';
+    }
+  }
+  SECTION("xor") {
+    target.subview(5) ^= view;
+    for (std::size_t i = 0; i < size; ++i) {
+      expected[5 + i] = (expected[5 + i] != inner[i]) ? '1' : '0';
+    }
+  }
+  CHECK_THAT(target, BitSetEqualsString(expected));
+}
+
+TEST_CASE("reversed view into a bitset") {
+  BitSet base("1101100111");
+  BitSet target(10, true);
+  target &= ReversedConstView(base);
+  CHECK_THAT(target, BitSetEqualsString("1110011011"));
+  target ^= ReversedConstView(base);
+  CHECK_THAT(target, BitSetEqualsString("0000000000"));
+  target |= ReversedConstView(base);
+  CHECK_THAT(target, BitSetEqualsString("1110011011"));
+}
+
+} // namespace ct::test
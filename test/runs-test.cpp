@@ -0,0 +1,118 @@
+#include "bitset.h"
+#include "test-helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ct::test {
+
+namespace {
+
+std::vector<BitRun> expected_runs(std::string_view str, char value) {
+  std::vector<BitRun> result;
+  for (std::size_t i = 0; i < str.size(); ++i) {
+    if (str[i] == value && (i == 0 || str[i - 1] != value)) {
+      result.push_back({i, 0});
+    }
+    if (str[i] == value) {
+      ++result.back().length;
+    }
+  }
+  return result;
+}
+
+// An empty run is found at the start
+std::size_t expected_find_run(std::string_view str, std::size_t min_length, char value) {
+  if (min_length == 0) {
+    return 0;
+  }
+  for (const BitRun& run : expected_runs(str, value)) {
+    if (run.length >= min_length) {
+      return run.start;
+    }
+  }
+  return BitSet::NPOS;
+}
+
+// Runs of random lengths, long ones included, so that they cross and cover whole words
+std::string random_runs(std::size_t size, std::mt19937_64& rng) {
+  std::geometric_distribution<std::size_t> short_run(0.3);
+  std::uniform_int_distribution<std::size_t> long_run(1, 300);
+  std::string result;
+  char value = '0';
+  while (result.size() < size) {
+    std::size_t length = (rng() % 4 == 0) ? long_run(rng) : short_run(rng) + 1;
+    result.append(std::min(length, size - result.size()), value);
+    value = (value == '0') ? '1' : '0';
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("runs of a bitset") {
+  const BitSet bs("0011101000000001");
+  CHECK(std::vector(bs.runs().begin(), bs.runs().end()) == std::vector<BitRun>{{2, 3}, {6, 1}, {15, 1}});
+  CHECK(std::vector(bs.zero_runs().begin(), bs.zero_runs().end()) == std::vector<BitRun>{{0, 2}, {5, 1}, {7, 8}});
+
+  std::vector<BitRun> runs;
+  for (const BitRun& run : bs.subview(3, 10).runs()) {
+    runs.push_back(run);
+  }
+  CHECK(runs == std::vector<BitRun>{{0, 2}, {3, 1}});
+
+  const BitSet empty;
+  CHECK(empty.runs().begin() == empty.runs().end());
+  const BitSet zeros(100, false);
+  RunRange ones = zeros.runs();
+  CHECK(ones.begin() == ones.end());
+  CHECK(*BitSet(100, false).zero_runs().begin() == BitRun{0, 100});
+}
+
+TEST_CASE("runs match bit by bit iteration") {
+  std::size_t size = GENERATE(1, 63, 64, 65, 200, 1'000, 5'000);
+  std::size_t offset = GENERATE(0, 1, 63);
+  CAPTURE(size, offset);
+  std::mt19937_64 rng(size + offset);
+  std::string str = random_runs(size + offset, rng);
+  BitSet bs(str);
+  BitSet::ConstView view = bs.subview(offset);
+  std::string_view expected = std::string_view(str).substr(offset);
+
+  CHECK(std::vector(view.runs().begin(), view.runs().end()) == expected_runs(expected, '1'));
+  CHECK(std::vector(view.zero_runs().begin(), view.zero_runs().end()) == expected_runs(expected, '0'));
+
+  for (std::size_t min_length : {0, 1, 2, 5, 17, 63, 64, 65, 130, 250}) {
+    CAPTURE(min_length);
+    CHECK(view.find_run(min_length) == expected_find_run(expected, min_length, '0'));
+    CHECK(view.find_run(min_length, true) == expected_find_run(expected, min_length, '1'));
+  }
+}
+
+TEST_CASE("find run of clear bits") {
+  BitSet bs(300, true);
+  CHECK(bs.find_run(0) == 0);
+  CHECK(bs.find_run(1) == BitSet::NPOS);
+
+  bs.subview(10, 3).reset();
+  bs.subview(60, 10).reset();
+  bs.subview(128, 64).reset();
+  bs.subview(290).reset();
+  CHECK(bs.find_run(1) == 10);
+  CHECK(bs.find_run(4) == 60);
+  CHECK(bs.find_run(11) == 128);
+  CHECK(bs.find_run(64) == 128);
+  CHECK(bs.find_run(65) == BitSet::NPOS);
+  CHECK(bs.find_run(10, true) == 0);
+  CHECK(bs.find_run(11, true) == 13);
+  CHECK(bs.find_run(48, true) == 70);
+  CHECK(bs.find_run(60, true) == 192);
+  CHECK(bs.subview(291).find_run(9) == 0);
+  CHECK(bs.subview(291).find_run(10) == BitSet::NPOS);
+}
+
+} // namespace ct::test
@@ -0,0 +1,105 @@
+#include "bitset-shared.h"
+#include "test-helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ct::test {
+
+TEST_CASE("shared bitset copies share storage") {
+  SharedBitSet original(BitSet("1101100111"));
+  CHECK(original.unique());
+
+  SharedBitSet copy = original;
+  CHECK_FALSE(original.unique());
+  CHECK_FALSE(copy.unique());
+  CHECK(copy.view().data() == original.view().data());
+  CHECK(copy.view() == BitSet("1101100111"));
+
+  const SharedBitSet& readonly = copy;
+  CHECK(readonly[0]);
+  CHECK_FALSE(readonly[2]);
+  CHECK_FALSE(copy.unique());
+}
+
+TEST_CASE("shared bitset detaches on modification") {
+  SharedBitSet original(BitSet("1101100111"));
+  SharedBitSet copy = original;
+
+  SECTION("reference") {
+    copy[0] = false;
+    CHECK_THAT(BitSet(copy.view()), BitSetEqualsString("0101100111"));
+  }
+
+  SECTION("view") {
+    copy.mutable_view().subview(0, 3).flip();
+    CHECK_THAT(BitSet(copy.view()), BitSetEqualsString("0011100111"));
+  }
+
+  SECTION("bitwise operations") {
+    copy &= BitSet("0111111111");
+    copy |= BitSet("0000000001");
+    copy ^= BitSet("1000000000");
+    CHECK_THAT(BitSet(copy.view()), BitSetEqualsString("1101100111"));
+  }
+
+  SECTION("with itself") {
+    copy ^= original;
+    CHECK_THAT(BitSet(copy.view()), BitSetEqualsString("0000000000"));
+  }
+
+  SECTION("flip") {
+    copy.flip();
+    CHECK_THAT(BitSet(copy.view()), BitSetEqualsString("0010011000"));
+  }
+
+  SECTION("set and reset") {
+    copy.set();
+    CHECK_THAT(BitSet(copy.view()), BitSetEqualsString("1111111111"));
+    copy.reset();
+    CHECK_THAT(BitSet(copy.view()), BitSetEqualsString("0000000000"));
+  }
+
+  CHECK(original.unique());
+  CHECK(copy.unique());
+  CHECK(copy.view().data() != original.view().data());
+  CHECK_THAT(BitSet(original.view()), BitSetEqualsString("1101100111"));
+}
+
+TEST_CASE("shared bitset does not copy a unique buffer") {
+  SharedBitSet bits(100, false);
+  const BitSet::Word* data = bits.view().data();
+  bits[5] = true;
+  bits |= BitSet(100, true);
+  bits.mutable_view().reset();
+  CHECK(bits.view().data() == data);
+
+  SharedBitSet other = bits;
+  other = SharedBitSet();
+  CHECK(bits.unique());
+  bits.flip();
+  CHECK(bits.view().data() == data);
+}
+
+TEST_CASE("shared bitset snapshots in threads") {
+  SharedBitSet bits(10'000, false);
+  std::vector<std::thread> readers;
+  std::vector<std::size_t> counts(4);
+  for (std::size_t i = 0; i < counts.size(); ++i) {
+    bits.mutable_view().subview(0, 1'000 * (i + 1)).set();
+    readers.emplace_back([snapshot = std::as_const(bits), &count = counts[i]] { count = snapshot.view().count(); });
+  }
+  bits.reset();
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+  for (std::size_t i = 0; i < counts.size(); ++i) {
+    CHECK(counts[i] == 1'000 * (i + 1));
+  }
+  CHECK(bits.view().count() == 0);
+}
+
+} // namespace ct::test
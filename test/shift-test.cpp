@@ -0,0 +1,111 @@
+#include "bitset.h"
+#include "test-helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+namespace ct::test {
+
+namespace {
+
+std::string random_string(std::size_t size, std::mt19937_64& rng) {
+  std::string result(size, '0');
+  std::bernoulli_distribution distribution;
+  std::ranges::generate(result, [&] { return distribution(rng) ? '1' : '0'; });
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("size-preserving shifts") {
+  BitSet bs("1101100111");
+
+  SECTION("left") {
+    bs.shift_left(3);
+    CHECK_THAT(bs, BitSetEqualsString("1100111000"));
+  }
+
+  SECTION("right") {
+    bs.shift_right(3);
+    CHECK_THAT(bs, BitSetEqualsString("0001101100"));
+  }
+
+  SECTION("rotate left") {
+    bs.rotate_left(3);
+    CHECK_THAT(bs, BitSetEqualsString("1100111110"));
+  }
+
+  SECTION("rotate right") {
+    bs.rotate_right(3);
+    CHECK_THAT(bs, BitSetEqualsString("1111101100"));
+  }
+
+  SECTION("by the size or more") {
+    BitSet copy = bs;
+    copy.rotate_left(20);
+    CHECK(copy == bs);
+    copy.rotate_right(13);
+    bs.rotate_right(3);
+    CHECK(copy == bs);
+    bs.shift_left(10);
+    CHECK_THAT(bs, BitSetEqualsString("0000000000"));
+    copy.shift_right(100);
+    CHECK_THAT(copy, BitSetEqualsString("0000000000"));
+  }
+
+  SECTION("empty") {
+    BitSet empty;
+    empty.shift_left(1).shift_right(1).rotate_left(1).rotate_right(1);
+    CHECK(empty.empty());
+  }
+}
+
+TEST_CASE("shifts and rotations of misaligned views") {
+  auto [offset, size] = GENERATE(table<std::size_t, std::size_t>({
+      {0, 1},
+      {3, 60},
+      {5, 64},
+      {64, 128},
+      {7, 300},
+      {13, 10'000},
+  }));
+  std::size_t count = GENERATE(0, 1, 17, 63, 64, 65, 150, 4'099, 5'000, 9'999);
+  CAPTURE(offset, size, count);
+
+  std::mt19937_64 rng(offset * 31 + size);
+  std::string str = random_string(offset + size + 70, rng);
+  BitSet bs(str);
+  BitSet::View view = bs.subview(offset, size);
+  std::string inner = str.substr(offset, size);
+  std::size_t shift = std::min(count, size);
+  std::size_t rotation = count % size;
+
+  SECTION("shift left") {
+    view.shift_left(count);
+    inner = inner.substr(shift) + std::string(shift, '0');
+  }
+
+  SECTION("shift right") {
+    view.shift_right(count);
+    inner = std::string(shift, '0') + inner.substr(0, size - shift);
+  }
+
+  SECTION("rotate left") {
+    view.rotate_left(count);
+    std::ranges::rotate(inner, inner.begin() + static_cast<std::ptrdiff_t>(rotation));
+  }
+
+  SECTION("rotate right") {
+    view.rotate_right(count);
+    std::ranges::rotate(inner, inner.end() - static_cast<std::ptrdiff_t>(rotation));
+  }
+
+  str.replace(offset, size, inner);
+  CHECK_THAT(bs, BitSetEqualsString(str));
+}
+
+} // namespace ct::test
@@ -0,0 +1,101 @@
+#include "bitset.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace ct::test {
+
+TEST_CASE("stats are zero when disabled") {
+  if constexpr (!detail::STATS_ENABLED) {
+    BitSet bs(200, true);
+    bs &= BitSet(200, false);
+    bs[3] = true;
+    CHECK(bitset_stats() == BitSetStats());
+  }
+}
+
+TEST_CASE("stats count allocations") {
+  if constexpr (detail::STATS_ENABLED) {
+    reset_bitset_stats();
+    {
+      BitSet bs(130, false);
+      BitSet copy = bs;
+    }
+    BitSetStats stats = bitset_stats();
+    CHECK(stats.allocations == 2);
+    CHECK(stats.deallocations == 2);
+    CHECK(stats.allocated_bytes == 2 * 3 * sizeof(BitSet::Word));
+  }
+}
+
+TEST_CASE("stats separate aligned and misaligned kernels") {
+  if constexpr (detail::STATS_ENABLED) {
+    BitSet lhs(64 * 10, true);
+    const BitSet rhs(64 * 12, false);
+
+    reset_bitset_stats();
+    lhs &= rhs.subview(64, 64 * 10);
+    BitSetStats stats = bitset_stats();
+    CHECK(stats.transform == KernelStats{10, 0, 0});
+
+    reset_bitset_stats();
+    lhs &= rhs.subview(3, 64 * 10);
+    stats = bitset_stats();
+    CHECK(stats.transform == KernelStats{0, 10, 0});
+
+    reset_bitset_stats();
+    lhs.subview(3, 64 * 9).flip();
+    stats = bitset_stats();
+    CHECK(stats.scan == KernelStats{8, 0, 2});
+  }
+}
+
+TEST_CASE("stats show index extraction stopping when the output is full") {
+  if constexpr (detail::STATS_ENABLED) {
+    const BitSet bs(64 * 100, true);
+    std::vector<std::uint32_t> out(70);
+
+    reset_bitset_stats();
+    CHECK(bs.subview(3).to_indices(out) == out.size());
+    CHECK(bitset_stats().scan == KernelStats{1, 0, 1});
+    CHECK(out.back() == 69);
+  }
+}
+
+TEST_CASE("stats count per-bit fallbacks") {
+  if constexpr (detail::STATS_ENABLED) {
+    BitSet bs(100, false);
+
+    reset_bitset_stats();
+    for (std::size_t i = 0; i < bs.size(); ++i) {
+      bs[i] = true;
+    }
+    bs[0].flip();
+    BitSet copy(bs.begin() + 1, bs.end());
+    BitSetStats stats = bitset_stats();
+    CHECK(stats.reference_writes == 101);
+    CHECK(stats.iterator_constructions == 1);
+  }
+}
+
+TEST_CASE("stats are summed over threads") {
+  if constexpr (detail::STATS_ENABLED) {
+    reset_bitset_stats();
+    std::thread worker([] {
+      BitSet bs(10, false);
+      bs[0] = true;
+    });
+    worker.join();
+    BitSet bs(10, false);
+    bs[0] = true;
+
+    BitSetStats stats = bitset_stats();
+    CHECK(stats.allocations == 2);
+    CHECK(stats.reference_writes == 2);
+  }
+}
+
+} // namespace ct::test
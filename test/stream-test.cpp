@@ -0,0 +1,105 @@
+#include "bitset-stream.h"
+#include "test-helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace ct::test {
+
+TEST_CASE("bit writer appends fields most significant bit first") {
+  BitWriter writer;
+  writer.write(0b101, 3);
+  writer.write_bit(false);
+  writer.write(0xff'ff'ff'ff'ff'ff'ff'f1, 4);
+  writer.write_unary(2);
+  writer.write(BitSet("0110").subview(1));
+  CHECK(writer.size() == 14);
+  CHECK_THAT(writer.to_bitset(), BitSetEqualsString("10100001001110"));
+
+  writer.write(1, 1);
+  BitSet moved = std::move(writer).to_bitset();
+  CHECK_THAT(moved, BitSetEqualsString("101000010011101"));
+  CHECK(writer.size() == 0);
+
+  writer.reserve(1'000);
+  writer.write(~BitSet::Word(0), 64);
+  writer.clear();
+  CHECK(writer.size() == 0);
+  CHECK(writer.to_bitset().empty());
+}
+
+TEST_CASE("bit writer and reader round trip") {
+  std::size_t seed = GENERATE(1, 2, 3);
+  CAPTURE(seed);
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<std::size_t> widths(0, 64);
+
+  std::vector<std::pair<std::uint64_t, std::size_t>> fields;
+  BitWriter writer;
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < 1'000; ++i) {
+    std::size_t width = widths(rng);
+    std::uint64_t value = (width == 0) ? 0 : rng() >> (64 - width);
+    fields.emplace_back(value, width);
+    writer.write(value, width);
+    size += width;
+  }
+  REQUIRE(writer.size() == size);
+
+  BitSet bits = writer.to_bitset();
+  BitReader reader(bits);
+  for (auto [value, width] : fields) {
+    CHECK(reader.peek(width) == value);
+    CHECK(reader.read(width) == value);
+  }
+  CHECK(reader.position() == size);
+  CHECK(reader.remaining() == 0);
+}
+
+TEST_CASE("bit reader decodes elias gamma codes") {
+  std::vector<std::uint64_t> values = {1, 2, 3, 7, 8, 1'000, std::uint64_t(1) << 40, std::uint64_t(-1)};
+  BitWriter writer;
+  writer.write(0b101, 3);
+  for (std::uint64_t value : values) {
+    auto length = static_cast<std::size_t>(std::bit_width(value));
+    writer.write_unary(length - 1);
+    writer.write(value, length - 1);
+  }
+
+  BitSet bits = writer.to_bitset();
+  BitReader reader(bits.subview(3));
+  for (std::uint64_t value : values) {
+    std::size_t length = reader.read_unary() + 1;
+    CHECK(((std::uint64_t(1) << (length - 1)) | reader.read(length - 1)) == value);
+  }
+  CHECK(reader.remaining() == 0);
+}
+
+TEST_CASE("bit reader at the end of the view") {
+  BitSet bits("0000001011");
+  BitReader reader(bits.subview(0, 9));
+  CHECK(reader.peek(12) == 0b000000101000);
+  CHECK(reader.read_unary() == 6);
+  reader.skip(1);
+  CHECK(reader.read_unary() == 0);
+  CHECK(reader.remaining() == 0);
+  CHECK(reader.peek(64) == 0);
+
+  BitSet zeros(200, false);
+  BitReader long_run(zeros.subview(5));
+  CHECK(long_run.read_unary() == 195);
+  CHECK(long_run.remaining() == 0);
+
+  zeros[150] = true;
+  BitReader one(zeros.subview(5));
+  CHECK(one.read_unary() == 145);
+  CHECK(one.position() == 146);
+}
+
+} // namespace ct::test
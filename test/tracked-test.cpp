@@ -0,0 +1,178 @@
+#include "bitset-tracked.h"
+#include "test-helpers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace ct::test {
+
+namespace {
+
+constexpr std::size_t CHUNK = TrackedBitSet::CHUNK_BITS;
+
+std::vector<std::uint64_t> dirty_chunks(const TrackedBitSet& bits) {
+  std::vector<std::uint64_t> result;
+  bits.dirty().append_indices(result);
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("tracked bitset marks modified chunks") {
+  TrackedBitSet bits(10 * CHUNK + 100, false);
+  CHECK(bits.dirty().size() == 11);
+  CHECK_FALSE(bits.dirty().any());
+
+  bits[3 * CHUNK + 5] = true;
+  CHECK(dirty_chunks(bits) == std::vector<std::uint64_t>{3});
+
+  bits.mutable_view(5 * CHUNK - 1, 2).set();
+  CHECK(dirty_chunks(bits) == std::vector<std::uint64_t>{3, 4, 5});
+
+  std::vector<std::size_t> indices = {10 * CHUNK + 99, 7};
+  bits.set_bits(indices);
+  CHECK(dirty_chunks(bits) == std::vector<std::uint64_t>{0, 3, 4, 5, 10});
+
+  bits.clear_dirty();
+  CHECK_FALSE(bits.dirty().any());
+
+  const TrackedBitSet& readonly = bits;
+  CHECK(readonly[7]);
+  CHECK(readonly.view().count() == 5);
+  CHECK_FALSE(bits.dirty().any());
+
+  bits.flip();
+  CHECK(bits.dirty().all());
+}
+
+TEST_CASE("tracked bitset marks writes through handles kept across checkpoints") {
+  TrackedBitSet bits(4 * CHUNK, false);
+  TrackedBitSet::Reference bit = bits[CHUNK + 1];
+  TrackedBitSet::View view = bits.mutable_view(2 * CHUNK + 10, CHUNK);
+  CHECK_FALSE(bits.dirty().any());
+
+  bit = true;
+  CHECK(dirty_chunks(bits) == std::vector<std::uint64_t>{1});
+  bits.clear_dirty();
+  bit.flip();
+  CHECK(dirty_chunks(bits) == std::vector<std::uint64_t>{1});
+  CHECK_FALSE(bits.view()[CHUNK + 1]);
+
+  bits.clear_dirty();
+  view.set();
+  CHECK(dirty_chunks(bits) == std::vector<std::uint64_t>{2, 3});
+  bits.clear_dirty();
+  view.subview(CHUNK - 5)[1] = false;
+  CHECK(dirty_chunks(bits) == std::vector<std::uint64_t>{3});
+  bits.clear_dirty();
+  view.subview(0, 3).shift_left(1);
+  CHECK(dirty_chunks(bits) == std::vector<std::uint64_t>{2});
+  CHECK(bits.view().count() == CHUNK - 2);
+  CHECK(TrackedBitSet::ConstView(view).count() == CHUNK - 2);
+}
+
+TEST_CASE("tracked bitset marks only the chunks of batched writes") {
+  TrackedBitSet bits(10 * CHUNK, false);
+  std::vector<std::size_t> indices = {CHUNK + 3, 6 * CHUNK};
+
+  bits.set_bits(indices);
+  CHECK(dirty_chunks(bits) == std::vector<std::uint64_t>{1, 6});
+  bits.clear_dirty();
+  bits.flip_bits(std::vector<std::size_t>{CHUNK + 3});
+  CHECK(dirty_chunks(bits) == std::vector<std::uint64_t>{1});
+  bits.clear_dirty();
+  bits.reset_bits(indices);
+  CHECK(dirty_chunks(bits) == std::vector<std::uint64_t>{1, 6});
+  CHECK_FALSE(bits.view().any());
+
+  bits.clear_dirty();
+  TrackedBitSet::View view = bits.mutable_view(2 * CHUNK + 1);
+  view.set_bits(indices);
+  CHECK(dirty_chunks(bits) == std::vector<std::uint64_t>{3, 8});
+  view.flip_bits(std::vector<std::size_t>{0});
+  view.reset_bits(std::vector<std::size_t>{CHUNK + 3});
+  CHECK(dirty_chunks(bits) == std::vector<std::uint64_t>{2, 3, 8});
+  CHECK(bits.view().count() == 2);
+}
+
+TEST_CASE("tracked bitset marks only chunks changed by bitwise operations") {
+  TrackedBitSet bits(4 * CHUNK, true);
+  BitSet other(4 * CHUNK, true);
+  other[2 * CHUNK + 1] = false;
+
+  bits &= other;
+  CHECK(dirty_chunks(bits) == std::vector<std::uint64_t>{2});
+
+  bits.clear_dirty();
+  bits |= other;
+  CHECK_FALSE(bits.dirty().any());
+
+  bits ^= BitSet(4 * CHUNK, false).subview();
+  CHECK_FALSE(bits.dirty().any());
+
+  BitSet shifted(4 * CHUNK + 3, true);
+  shifted[3 * CHUNK + 3] = false;
+  bits &= shifted.subview(3);
+  CHECK(dirty_chunks(bits) == std::vector<std::uint64_t>{3});
+  CHECK(bits.view().count() == 4 * CHUNK - 2);
+}
+
+TEST_CASE("tracked bitset replicates deltas") {
+  std::size_t size = GENERATE(0, 1, 100, CHUNK, 7 * CHUNK + 13);
+  CAPTURE(size);
+
+  std::mt19937_64 rng(size);
+  TrackedBitSet leader(size, false);
+  TrackedBitSet follower(size, false);
+
+  for (std::size_t round = 0; round < 5 && size != 0; ++round) {
+    std::uniform_int_distribution<std::size_t> position(0, size - 1);
+    for (std::size_t i = 0; i < 3; ++i) {
+      leader[position(rng)].flip();
+    }
+    std::vector<std::byte> delta = leader.export_delta();
+    CHECK(delta.size() <= 8 * (1 + 3 * (2 + TrackedBitSet::CHUNK_WORDS)));
+    leader.clear_dirty();
+
+    REQUIRE(follower.apply_delta(delta));
+    CHECK(follower.view() == leader.view());
+  }
+
+  TrackedBitSet full(BitSet(size, true));
+  full.mutable_view().set();
+  REQUIRE(follower.apply_delta(full.export_delta()));
+  CHECK(follower.view() == full.view());
+  CHECK(follower.dirty().all());
+}
+
+TEST_CASE("tracked bitset rejects malformed deltas") {
+  TrackedBitSet leader(3 * CHUNK, false);
+  leader[CHUNK] = true;
+  std::vector<std::byte> delta = leader.export_delta();
+  TrackedBitSet follower(3 * CHUNK, false);
+
+  CHECK_FALSE(follower.apply_delta({}));
+  CHECK_FALSE(follower.apply_delta(std::span(delta).first(delta.size() - 1)));
+  CHECK_FALSE(TrackedBitSet(2 * CHUNK, false).apply_delta(delta));
+
+  std::vector<std::byte> out_of_range = delta;
+  out_of_range[8] = std::byte(3);
+  CHECK_FALSE(follower.apply_delta(out_of_range));
+
+  std::vector<std::byte> empty_run = delta;
+  empty_run[16] = std::byte(0);
+  CHECK_FALSE(follower.apply_delta(empty_run));
+
+  CHECK_FALSE(follower.view().any());
+  CHECK_FALSE(follower.dirty().any());
+
+  CHECK(follower.apply_delta(std::span(delta).first(8)));
+  CHECK(follower.apply_delta(delta));
+  CHECK(follower.view() == leader.view());
+}
+
+} // namespace ct::test
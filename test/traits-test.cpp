@@ -64,6 +64,8 @@ TEST_CASE("triviality") {
   SECTION("iterators") {
     STATIC_CHECK(std::is_trivial_v<BitSet::Iterator>);
     STATIC_CHECK(std::is_trivial_v<BitSet::ConstIterator>);
+    STATIC_CHECK(BitSet::Iterator{} == BitSet::Iterator{});
+    STATIC_CHECK(BitSet::ConstIterator{} == BitSet::ConstIterator{});
   }
   SECTION("views") {
     STATIC_CHECK(std::is_trivially_copyable_v<BitSet::View>);